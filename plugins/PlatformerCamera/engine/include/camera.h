@@ -13,6 +13,24 @@
 #define CAMERA_LOCK_Y_FLAG 0x02
 #define CAMERA_UNLOCKED 0x00
 
+//Lead and catch-up are looked up in tables built by camera_reset(), one entry per pixel of distance
+#define CAMERA_TABLE_SIZE 64
+//Gaps wider than that are looked up in a coarser table with one entry per 64px, which covers anything inside a scene
+#define CAMERA_COARSE_SIZE 32
+#define CAMERA_CATCHUP_EASED 4
+
+//Most the camera moves on an axis in a frame with plat_camera_scroll_cap on, so that scroll_update() never has to
+//draw more than one new column and one new row of background tiles in a frame
+#define CAMERA_SCROLL_CAP 8
+
+//While frames are lagging, the camera only catches up every other frame when the player is closer than this (in pixels)
+//to where the deadzone wants the camera, so it never falls far enough behind to lose the player
+#define CAMERA_SHED_DEFER 16
+
+//Pixels to move the camera for a distance of d pixels. Gaps of 64px or more use the coarse table, whose entries are
+//the step for the start of each 64px block, so the camera never overshoots and closes the rest on the next frames
+#define CAMERA_STEP(table, coarse, d) (((d) < CAMERA_TABLE_SIZE) ? (table)[(d)] : ((d) < (CAMERA_COARSE_SIZE << 6)) ? (coarse)[(d) >> 6] : (coarse)[CAMERA_COARSE_SIZE - 1])
+
 extern INT16 camera_x;
 extern INT16 camera_y;
 extern BYTE camera_offset_x;
@@ -23,12 +41,21 @@ extern UBYTE camera_settings;
 extern UBYTE plat_camera_follow;
 extern UBYTE plat_camera_lead;
 extern UBYTE plat_camera_catchup;
+extern UBYTE plat_camera_catchup_y;
+extern UBYTE plat_camera_scroll_cap;
+extern UWORD camera_step_max;
+extern BYTE camera_lead_table[CAMERA_TABLE_SIZE];
+extern UBYTE camera_catchup_x_table[CAMERA_TABLE_SIZE];
+extern UBYTE camera_catchup_y_table[CAMERA_TABLE_SIZE];
+extern UWORD camera_catchup_x_coarse[CAMERA_COARSE_SIZE];
+extern UWORD camera_catchup_y_coarse[CAMERA_COARSE_SIZE];
 extern WORD pl_vel_x;
 //plat_camera_follow stores info as 4 bits: Up, Down, Left, Right
 
 
 void camera_init() BANKED;
 void camera_reset() BANKED;
+void camera_build_tables() BANKED;
 void camera_update() NONBANKED;
 
 #endif
\ No newline at end of file
@@ -2,6 +2,11 @@
 
 #include "camera.h"
 #include "actor.h"
+#include "math.h"
+#include "pp_profiler.h"
+#include "pp_fixed.h"
+#include "pp_lag.h"
+#include "game_time.h"
 
 INT16 camera_x;
 INT16 camera_y;
@@ -13,6 +18,14 @@ UBYTE camera_settings;
 UBYTE plat_camera_follow;
 UBYTE plat_camera_lead;
 UBYTE plat_camera_catchup;
+UBYTE plat_camera_catchup_y;
+UBYTE plat_camera_scroll_cap;
+UWORD camera_step_max;                              //Furthest the camera can move on an axis in one frame
+BYTE camera_lead_table[CAMERA_TABLE_SIZE];          //Lead in pixels, indexed by the player's x-velocity / 4 (in whole subpixels) + 32
+UBYTE camera_catchup_x_table[CAMERA_TABLE_SIZE];    //Pixels to move, indexed by the distance outside of the deadzone
+UBYTE camera_catchup_y_table[CAMERA_TABLE_SIZE];
+UWORD camera_catchup_x_coarse[CAMERA_COARSE_SIZE];  //Pixels to move, indexed by the distance outside of the deadzone / 64
+UWORD camera_catchup_y_coarse[CAMERA_COARSE_SIZE];
 
 void camera_init() BANKED {
     camera_x = camera_y = 0;
@@ -23,19 +36,58 @@ void camera_init() BANKED {
 void camera_reset() BANKED {
     camera_deadzone_x = camera_deadzone_y = 0;
     camera_settings = CAMERA_LOCK_FLAG;
+    camera_build_tables();
+}
+
+static UBYTE camera_catchup_step(UBYTE d, UBYTE mode) {
+    if (d == 0) {
+        return 0;
+    }
+    if (mode == CAMERA_CATCHUP_EASED) {
+        //Crawl when close, and speed up until it closes 32px or more in one frame
+        UWORD step = ((UWORD)d * d) >> 5;
+        return (step == 0) ? 1 : MIN(step, d);
+    }
+    //Same as the old a_x >> catchup, but rounded up so that both directions reach the player
+    return (d + (1 << mode) - 1) >> mode;
+}
 
+static UWORD camera_catchup_coarse_step(UBYTE block, UBYTE mode) {
+    //Past the fine table the extra distance is divided by the same power of two the catch-up setting uses (none for
+    //Instant and Eased, which close big gaps at once anyway), so a slow camera never snaps across a wide gap
+    UBYTE shift = (mode == CAMERA_CATCHUP_EASED) ? 0 : mode;
+    UWORD step = camera_catchup_step(CAMERA_TABLE_SIZE - 1, mode) + ((((UWORD)block << 6) - (CAMERA_TABLE_SIZE - 1)) >> shift);
+    return MIN(step, camera_step_max);
+}
+
+void camera_build_tables() BANKED {
+    camera_step_max = (plat_camera_scroll_cap) ? CAMERA_SCROLL_CAP : 0xFFFF;
+    for (UBYTE i = 0; i != CAMERA_TABLE_SIZE; i++) {
+        WORD lead = ((BYTE)i - 32) * plat_camera_lead;
+        camera_lead_table[i] = CLAMP(lead, -127, 127);
+        camera_catchup_x_table[i] = MIN(camera_catchup_step(i, plat_camera_catchup), camera_step_max);
+        camera_catchup_y_table[i] = MIN(camera_catchup_step(i, plat_camera_catchup_y), camera_step_max);
+    }
+    //Block 0 is never read, the fine table covers it
+    for (UBYTE i = 1; i != CAMERA_COARSE_SIZE; i++) {
+        camera_catchup_x_coarse[i] = camera_catchup_coarse_step(i, plat_camera_catchup);
+        camera_catchup_y_coarse[i] = camera_catchup_coarse_step(i, plat_camera_catchup_y);
+    }
 }
 
 void camera_update() NONBANKED {
+    PP_PROFILE_BEGIN(PP_ZONE_CAMERA_UPDATE);
     /*
      I need to have an option for catchup speed. Otherwise the deadzone can get too wild.
 
     */
+    //Catch-up is shed this frame, see CAMERA_SHED_DEFER
+    UBYTE camera_defer = pp_shed && (game_time & 1);
 
     if ((camera_settings & CAMERA_LOCK_X_FLAG)) {
         //Difference between player position and camera_x
         //The 8 in this formula is necessary for centering the camera, presumably because the sprite starts at x = 0
-        WORD a_x = camera_x  - ((PLAYER.pos.x >> 4) + 8 + ((pl_vel_x >> 10)*plat_camera_lead));
+        WORD a_x = camera_x  - ((PLAYER.pos.x >> 4) + 8 + camera_lead_table[(UBYTE)((VEL_WHOLE(pl_vel_x) >> 2) + 32)]);
 
         //Even out camera catchup to velocity but not when re-orienting.
         /*if (pl_vel_x != 0 && plat_camera_lead != 0){
@@ -45,10 +97,14 @@ void camera_update() NONBANKED {
         //Camera - Player = Negative when Player is to the right and camera is catching up by moving right
         if (plat_camera_follow & 1 && a_x < -camera_deadzone_x + camera_offset_x) {
             a_x = a_x + camera_deadzone_x + camera_offset_x;
-            camera_x -= a_x >> plat_camera_catchup;
+            if (!camera_defer || -a_x >= CAMERA_SHED_DEFER) {
+                camera_x += CAMERA_STEP(camera_catchup_x_table, camera_catchup_x_coarse, (UWORD)-a_x);
+            }
         } else if (plat_camera_follow & 2 && a_x > camera_deadzone_x + camera_offset_x) {
             a_x = a_x - camera_deadzone_x + camera_offset_x;
-            camera_x -= a_x >> plat_camera_catchup;
+            if (!camera_defer || a_x >= CAMERA_SHED_DEFER) {
+                camera_x -= CAMERA_STEP(camera_catchup_x_table, camera_catchup_x_coarse, (UWORD)a_x);
+            }
         }
     }
 
@@ -57,10 +113,17 @@ void camera_update() NONBANKED {
         // Vertical lock
         //Camera Downwards Movement
          if (plat_camera_follow & 4 && camera_y + camera_deadzone_y + camera_offset_y < a_y) { 
-            camera_y = a_y - camera_deadzone_y - camera_offset_y;
+            UWORD d_y = a_y - camera_deadzone_y - camera_offset_y - camera_y;
+            if (!camera_defer || d_y >= CAMERA_SHED_DEFER) {
+                camera_y += CAMERA_STEP(camera_catchup_y_table, camera_catchup_y_coarse, d_y);
+            }
         //Camera Upwards Movement
         } else if (plat_camera_follow & 8 && camera_y + camera_offset_y > a_y + camera_deadzone_y) { 
-            camera_y = a_y + camera_deadzone_y - camera_offset_y;
+            UWORD d_y = camera_y - (a_y + camera_deadzone_y - camera_offset_y);
+            if (!camera_defer || d_y >= CAMERA_SHED_DEFER) {
+                camera_y -= CAMERA_STEP(camera_catchup_y_table, camera_catchup_y_coarse, d_y);
+            }
         }
     }
+    PP_PROFILE_END();
 }
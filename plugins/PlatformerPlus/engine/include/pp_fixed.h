@@ -0,0 +1,22 @@
+#ifndef PP_FIXED_H
+#define PP_FIXED_H
+
+#include <gb/gb.h>
+
+//Positions are in subpixels (16 per pixel, 128 per tile) and velocities are in 1/256ths of a subpixel.
+//The SM83 can only shift a 16-bit value one bit at a time, so these get to the same numbers by picking bytes instead.
+//Positions are expected to stay below 0x8000, which holds for any scene up to 255 tiles wide or tall.
+
+//Whole subpixels of a velocity: the high byte, same as vel >> 8
+#define VEL_WHOLE(v)        ((BYTE)((UWORD)(v) >> 8))
+
+//Subpixel position to tile, same as pos >> 7
+#define SUBPX_TO_TILE(p)    ((UBYTE)((UWORD)((UWORD)(p) << 1) >> 8))
+
+//Subpixel position to 16px tile, same as pos >> 8
+#define SUBPX_TO_TILE16(p)  ((UBYTE)((UWORD)(p) >> 8))
+
+//Tile to subpixel position, same as tile << 7
+#define TILE_TO_SUBPX(t)    ((UWORD)((UWORD)(t) << 8) >> 1)
+
+#endif
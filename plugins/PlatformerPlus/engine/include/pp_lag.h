@@ -0,0 +1,22 @@
+#ifndef PP_LAG_H
+#define PP_LAG_H
+
+#include <gb/gb.h>
+
+//A lag frame is one where the VBlank wait found that the previous frame had already overrun its VBlank. While frames are
+//lagging, optional work is shed: actors below full rate drop one update tier further (see LOD_AUTO in actor.h), and the
+//camera catches up at half rate when the player isn't close to the edge of the screen. Player physics are never shed.
+
+//Frames that have to fit in a row after a lag frame before the shed work comes back
+#define PP_SHED_HOLD 60
+
+//Gaps of more than this many VBlanks between frames are pauses (the VM locked for dialogue, a fade) rather than lag
+#define PP_LAG_MAX_LOST 2
+
+extern UBYTE pp_lag_frames;     //Frames lost to lag since the scene started, stops at 255
+extern UBYTE pp_shed;           //Non-zero while optional work is being shed, counts down on frames that fit
+
+void pp_lag_reset() BANKED;
+void pp_lag_update() BANKED;
+
+#endif
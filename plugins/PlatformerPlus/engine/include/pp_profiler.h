@@ -0,0 +1,68 @@
+#ifndef PP_PROFILER_H
+#define PP_PROFILER_H
+
+#include <gb/gb.h>
+
+//Uncomment to build the zone profiler into the ROM. Without it every PP_PROFILE_* macro compiles to nothing.
+//#define PP_PROFILE
+
+//Zones are timed with DIV_REG, which ticks once every 256 CPU cycles (a DMG frame is roughly 274 ticks).
+//DIV is free-running and read-only, so it doesn't disturb TIMA users like the music driver.
+enum pp_profile_zones {
+    PP_ZONE_INPUT = 0,          //platform_update(): hitbox and collision cache refresh, A. Input Checks
+    PP_ZONE_SWITCH1,            //platform_update(): B. State Machine 1 & Acceleration
+    PP_ZONE_XCOL,               //platform_update(): gotoXCol
+    PP_ZONE_YCOL,               //platform_update(): gotoYCol
+    PP_ZONE_ACTORCOL,           //platform_update(): gotoActorCol
+    PP_ZONE_SWITCH2,            //platform_update(): gotoSwitch2
+    PP_ZONE_TRIGGERCOL,         //platform_update(): gotoTriggerCol
+    PP_ZONE_COUNTERS,           //platform_update(): gotoCounters & state scripts
+    PP_ZONE_ACTORS_UPDATE,      //actors_update()
+    PP_ZONE_CAMERA_UPDATE,      //camera_update()
+    PP_ZONE_FRAME,              //Sum of the zones above for one frame, closed when the next platform_update() starts
+    PP_ZONE_COUNT
+};
+
+//DMG frame budget (70224 cycles) in DIV ticks. PP_ZONE_FRAME against this is the share of the frame P+ is using.
+//Samples saturate at 255 ticks, so a pinned 255 max means the timed code alone is eating 93%+ of the frame.
+#define PP_FRAME_BUDGET 274
+
+//Number of samples averaged before a zone's avg is refreshed (must be a power of 2)
+#define PP_PROFILE_SAMPLES_SHIFT 4
+
+typedef struct pp_profile_zone_t {
+    UBYTE min;                  //Fastest sample, in DIV ticks
+    UBYTE avg;                  //Average of the last block of samples
+    UBYTE max;                  //Slowest sample
+    UBYTE samples;              //Samples in the current block
+    UWORD total;                //Running total for the current block
+} pp_profile_zone_t;
+
+#ifdef PP_PROFILE
+
+extern pp_profile_zone_t pp_profile_zones[PP_ZONE_COUNT];
+
+void pp_profile_reset() BANKED;
+void pp_profile_begin(UBYTE zone) NONBANKED;
+void pp_profile_end() NONBANKED;
+
+//Close the open zone (if any) and start timing the next one. Safe to use at goto labels, since whichever
+//section jumped there is the one that gets closed.
+#define PP_PROFILE_BEGIN(zone)  pp_profile_begin(zone)
+#define PP_PROFILE_END()        pp_profile_end()
+#define PP_PROFILE_RESET()      pp_profile_reset()
+
+#else
+
+#define PP_PROFILE_BEGIN(zone)
+#define PP_PROFILE_END()
+#define PP_PROFILE_RESET()
+
+#endif
+
+#include "vm.h"
+
+//Native for the Store Profiler Timing event. Always built, and returns 0 without PP_PROFILE.
+void pp_profile_get(SCRIPT_CTX * THIS) OLDCALL BANKED;
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PP_RECORDER_H
+#define PP_RECORDER_H
+
+#include <gb/gb.h>
+
+//Uncomment to record every frame of input into cartridge SRAM, for replaying playtest sessions.
+//Without it every PP_RECORD_* macro compiles to nothing.
+//#define PP_RECORD
+
+//SRAM bank the recording goes in. It must be a bank the save system doesn't use (GB Studio saves
+//from bank 0 up), and the cartridge needs enough RAM to have it.
+#define PP_RECORD_SRAM_BANK 3
+
+//The MBC's RAM registers can't be read back, so after each write the recorder puts them back the way GB Studio keeps
+//them: cartridge RAM enabled, with bank 0 (the first save slot) selected.
+#define PP_RECORD_RESTORE_BANK 0
+#define PP_RECORD_RESTORE_ENABLED 1
+
+//Layout of the SRAM bank (see tools/pp_recording.js for a reader):
+//  0x00    "PPR2"
+//  0x04    UWORD length of the data that follows, in bytes
+//  0x06    data: pairs of (joypad, frames) for each run of unchanged input, frames 1-255.
+//          A pair with frames == 0 is a marker instead, and its first byte says which:
+#define PP_RECORD_MARK_SCENE    0   //A platformer scene starts, followed by 7 bytes: the scene's bank, the scene's
+                                    //address (UWORD) and the player's x and y (UWORD, subpixels)
+#define PP_RECORD_MARK_PAUSED   1   //The frames after this didn't update the player (a script locked the VM, or it
+                                    //isn't a platformer scene), but their input still went to scripts
+#define PP_RECORD_MARK_RESUMED  2   //The player updates again from the next frame
+#define PP_RECORD_HEADER_SIZE 6
+#define PP_RECORD_SIZE 0x2000
+
+#ifdef PP_RECORD
+
+extern UWORD pp_record_stepped;
+
+void pp_record_scene() BANKED;
+void pp_record_input() BANKED;
+
+//PP_RECORD_INPUT() goes in actors_update(), which runs every frame even while scripts have the VM locked.
+//PP_RECORD_STEP() goes in platform_update(), to tell the frames that moved the player from the ones that didn't.
+#define PP_RECORD_SCENE()   pp_record_scene()
+#define PP_RECORD_INPUT()   pp_record_input()
+#define PP_RECORD_STEP()    pp_record_stepped = game_time
+
+#else
+
+#define PP_RECORD_SCENE()
+#define PP_RECORD_INPUT()
+#define PP_RECORD_STEP()
+
+#endif
+
+#endif
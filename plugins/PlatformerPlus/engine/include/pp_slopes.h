@@ -0,0 +1,34 @@
+#ifndef PP_SLOPES_H
+#define PP_SLOPES_H
+
+#include <gb/gb.h>
+
+//Slope tiles use the top three bits of a tile's collision value, so they never overlap the
+//direction bits or TILE_PROP_LADDER (0x10). A slope tile shouldn't have any direction bits set.
+#define COLLISION_SLOPE             0xE0
+#define COLLISION_SLOPE_45_UP       0x20    //Rises to the right, one pixel per pixel
+#define COLLISION_SLOPE_45_DOWN     0x40    //Falls to the right, one pixel per pixel
+#define COLLISION_SLOPE_22_UP_LOW   0x60    //Rises to the right, one pixel per two: lower half of the tile
+#define COLLISION_SLOPE_22_UP_HIGH  0x80    //Rises to the right, one pixel per two: upper half of the tile
+#define COLLISION_SLOPE_22_DOWN_HIGH 0xA0   //Falls to the right, one pixel per two: upper half of the tile
+#define COLLISION_SLOPE_22_DOWN_LOW 0xC0    //Falls to the right, one pixel per two: lower half of the tile
+
+//Distance in subpixels from the top of a slope tile down to its surface, for each pixel column.
+//It lives in bank 0 so any bank can read it.
+extern const UBYTE slope_surface[8][8];
+
+#define SLOPE_SURFACE(tile, px)     (slope_surface[(UBYTE)(tile) >> 5][(px)])
+
+//Side a slope rises towards. Walking that way off the top of it steps onto whatever is next to it in the same row.
+#define SLOPE_RISES_RIGHT(tile)     ((tile) == COLLISION_SLOPE_45_UP || (tile) == COLLISION_SLOPE_22_UP_LOW || (tile) == COLLISION_SLOPE_22_UP_HIGH)
+#define SLOPE_RISES_LEFT(tile)      ((tile) == COLLISION_SLOPE_45_DOWN || (tile) == COLLISION_SLOPE_22_DOWN_HIGH || (tile) == COLLISION_SLOPE_22_DOWN_LOW)
+
+//Code that doesn't follow the surface of a slope (actor movement, the dash's wall and gap searches) treats a slope tile
+//as solid from above like a one-way platform, and open from the sides and below, so the solid tiles behind a hill stop
+//things moving sideways. Test a tile against this instead of COLLISION_TOP there.
+#define COLLISION_TOP_OR_SLOPE      (COLLISION_TOP | COLLISION_SLOPE)
+
+//Pixel column (0-7) within its tile of a subpixel position, read from the low byte
+#define SUBPX_TILE_PX(p)            (((UBYTE)(p) >> 4) & 7)
+
+#endif
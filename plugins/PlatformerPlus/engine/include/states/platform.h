@@ -3,18 +3,71 @@
 
 #include <gb/gb.h>
 
+#include "collision.h"
+
 void platform_init();
 void platform_update();
-void basic_anim() BANKED;
-void wall_check() BANKED;
-void ladder_check() BANKED;
-void ladder_switch() BANKED;
 void dash_init_switch() BANKED;
-UBYTE drop_press() BANKED;
+void dash_index_build(UBYTE tile_x, UBYTE len) BANKED;
+
+enum pStates {              //Datatype for tracking states
+    FALL_INIT = 0,
+    FALL_STATE,
+    FALL_END,
+    GROUND_INIT,
+    GROUND_STATE,
+    GROUND_END,
+    JUMP_INIT,
+    JUMP_STATE,
+    JUMP_END,
+    DASH_INIT,
+    DASH_STATE,
+    DASH_END,
+    LADDER_INIT,
+    LADDER_STATE,
+    LADDER_END,
+    WALL_INIT,
+    WALL_STATE,
+    WALL_END,
+    KNOCKBACK_INIT,
+    KNOCKBACK_STATE,
+    BLANK_INIT,
+    BLANK_STATE
+};
+
+#define DASH_NO_WALL 255
+
+//Tiles around the player, refreshed by platform_update() when they cross a tile boundary
+#define TILE_CACHE_W 6
+#define TILE_CACHE_H 6
+extern UBYTE tile_cache[TILE_CACHE_H][TILE_CACHE_W];
+extern UBYTE tile_cache_x;
+extern UBYTE tile_cache_y;
+
+//Drop-in replacement for tile_at() that reads from the cache when it can, and from ROM when it can't (ie. long dashes)
+static inline UBYTE cached_tile_at(UBYTE tx, UBYTE ty) {
+    UBYTE cx = tx - tile_cache_x;
+    UBYTE cy = ty - tile_cache_y;
+    if (cx < TILE_CACHE_W && cy < TILE_CACHE_H){
+        return tile_cache[cy][cx];
+    }
+    return tile_at(tx, ty);
+}
+
+//When a state's script runs, set with the Attach Script event
+#define STATE_SCRIPT_EVERY_FRAME    0   //Every frame the player is in the state
+#define STATE_SCRIPT_ENTRY          1   //Once, on the frame the player enters the state
+#define STATE_SCRIPT_EXIT           2   //Once, on the frame the player leaves the state
+#define STATE_SCRIPT_FINISHED       3   //Every frame in the state, unless the last run is still going
+#define STATE_SCRIPT_PERIODIC       4   //Every script_period frames while in the state
 
 typedef struct script_state_t {
     UBYTE script_bank;
     UBYTE *script_addr;
+    UBYTE script_mode;
+    UBYTE script_period;
+    UBYTE script_timer;
+    UWORD script_thread;        //Handle of the last run, for STATE_SCRIPT_FINISHED
 } script_state_t;
 
 
@@ -62,5 +115,29 @@ extern UBYTE plat_dash_through;
 extern WORD plat_dash_dist;       
 extern UBYTE plat_dash_frames;
 extern UBYTE plat_dash_ready_max; 
+extern UBYTE plat_dash_deadzone;
+
+//Player state shared with dash_init_switch()
+extern enum pStates plat_state;
+extern enum pStates que_state;
+extern WORD dash_dist;
+extern UBYTE dash_ready_val;
+extern UBYTE dash_currentframe;
+extern BYTE tap_val;
+extern UBYTE dash_end_clear;
+extern UWORD dash_end_x;
+extern UBYTE dash_wall_dist;
+extern UBYTE dash_index_col;
+extern UBYTE dash_index_row;
+extern UBYTE dash_index_row_end;
+extern UBYTE dash_index_len;
+extern UBYTE dash_index_dir;
+extern UBYTE actor_attached;
+extern UBYTE jump_type;
+extern BYTE run_stage;
+extern WORD pl_box_left;
+extern WORD pl_box_right;
+extern WORD pl_box_top;
+extern WORD pl_box_bottom;
 
 #endif
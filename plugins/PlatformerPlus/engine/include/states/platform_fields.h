@@ -0,0 +1,140 @@
+#ifndef STATE_PLATFORM_FIELDS_H
+#define STATE_PLATFORM_FIELDS_H
+
+/*
+Compile-time values for the Platformer+ option fields.
+By default every option is read from its engine field each frame. Uncommenting a line below and setting it to the value 
+chosen in the project's settings turns that option into a constant inside platform.c, so the compiler can drop the code 
+for every choice the game doesn't use (run styles, dash inputs, wall logic...), saving cycles and bank 3 space.
+Leave a field commented out if it is changed at runtime by Update Engine Field: the engine field is ignored once its 
+constant is defined.
+*/
+//#define PLAT_CONST_CAMERA_BLOCK     0   //Lock Player to Camera Edge
+//#define PLAT_CONST_DROP_THROUGH     0   //Drop Through Platforms
+//#define PLAT_CONST_FLOAT_INPUT      0   //Float Input
+//#define PLAT_CONST_WALL_SLIDE       0   //Enable Wall Slide
+//#define PLAT_CONST_AIR_CONTROL      1   //Air Control
+//#define PLAT_CONST_TURN_CONTROL     1   //Change Avatar Direction in the Air
+//#define PLAT_CONST_RUN_TYPE         1   //Run Style
+//#define PLAT_CONST_DASH             0   //Dash Input
+//#define PLAT_CONST_DASH_STYLE       0   //Dash Style
+//#define PLAT_CONST_DASH_MOMENTUM    0   //Dash Momentum
+//#define PLAT_CONST_DASH_THROUGH     0   //Dash Through...
+
+//Nothing ties these values to engine.json or to the project settings, so they're kept in step by hand. Catch values that
+//aren't one of the field's options here, and a value that differs from the project setting in platform_init() (STRICT
+//builds only, see PLAT_CONST_MISMATCH).
+#if defined(PLAT_CONST_CAMERA_BLOCK) && (PLAT_CONST_CAMERA_BLOCK < 0 || PLAT_CONST_CAMERA_BLOCK > 3)
+#error "PLAT_CONST_CAMERA_BLOCK must be between 0 and 3"
+#endif
+#if defined(PLAT_CONST_DROP_THROUGH) && (PLAT_CONST_DROP_THROUGH < 0 || PLAT_CONST_DROP_THROUGH > 4)
+#error "PLAT_CONST_DROP_THROUGH must be between 0 and 4"
+#endif
+#if defined(PLAT_CONST_FLOAT_INPUT) && (PLAT_CONST_FLOAT_INPUT < 0 || PLAT_CONST_FLOAT_INPUT > 2)
+#error "PLAT_CONST_FLOAT_INPUT must be between 0 and 2"
+#endif
+#if defined(PLAT_CONST_WALL_SLIDE) && (PLAT_CONST_WALL_SLIDE < 0 || PLAT_CONST_WALL_SLIDE > 1)
+#error "PLAT_CONST_WALL_SLIDE must be between 0 and 1"
+#endif
+#if defined(PLAT_CONST_AIR_CONTROL) && (PLAT_CONST_AIR_CONTROL < 0 || PLAT_CONST_AIR_CONTROL > 1)
+#error "PLAT_CONST_AIR_CONTROL must be between 0 and 1"
+#endif
+#if defined(PLAT_CONST_TURN_CONTROL) && (PLAT_CONST_TURN_CONTROL < 0 || PLAT_CONST_TURN_CONTROL > 1)
+#error "PLAT_CONST_TURN_CONTROL must be between 0 and 1"
+#endif
+#if defined(PLAT_CONST_RUN_TYPE) && (PLAT_CONST_RUN_TYPE < 0 || PLAT_CONST_RUN_TYPE > 5)
+#error "PLAT_CONST_RUN_TYPE must be between 0 and 5"
+#endif
+#if defined(PLAT_CONST_DASH) && (PLAT_CONST_DASH < 0 || PLAT_CONST_DASH > 3)
+#error "PLAT_CONST_DASH must be between 0 and 3"
+#endif
+#if defined(PLAT_CONST_DASH_STYLE) && (PLAT_CONST_DASH_STYLE < 0 || PLAT_CONST_DASH_STYLE > 2)
+#error "PLAT_CONST_DASH_STYLE must be between 0 and 2"
+#endif
+#if defined(PLAT_CONST_DASH_MOMENTUM) && (PLAT_CONST_DASH_MOMENTUM < 0 || PLAT_CONST_DASH_MOMENTUM > 3)
+#error "PLAT_CONST_DASH_MOMENTUM must be between 0 and 3"
+#endif
+#if defined(PLAT_CONST_DASH_THROUGH) && (PLAT_CONST_DASH_THROUGH < 0 || PLAT_CONST_DASH_THROUGH > 3)
+#error "PLAT_CONST_DASH_THROUGH must be between 0 and 3"
+#endif
+
+#ifdef PLAT_CONST_CAMERA_BLOCK
+#define PLAT_CAMERA_BLOCK   PLAT_CONST_CAMERA_BLOCK
+#else
+#define PLAT_CAMERA_BLOCK   plat_camera_block
+#endif
+
+#ifdef PLAT_CONST_DROP_THROUGH
+#define PLAT_DROP_THROUGH   PLAT_CONST_DROP_THROUGH
+#else
+#define PLAT_DROP_THROUGH   plat_drop_through
+#endif
+
+#ifdef PLAT_CONST_FLOAT_INPUT
+#define PLAT_FLOAT_INPUT    PLAT_CONST_FLOAT_INPUT
+#else
+#define PLAT_FLOAT_INPUT    plat_float_input
+#endif
+
+#ifdef PLAT_CONST_WALL_SLIDE
+#define PLAT_WALL_SLIDE     PLAT_CONST_WALL_SLIDE
+#else
+#define PLAT_WALL_SLIDE     plat_wall_slide
+#endif
+
+#ifdef PLAT_CONST_AIR_CONTROL
+#define PLAT_AIR_CONTROL    PLAT_CONST_AIR_CONTROL
+#else
+#define PLAT_AIR_CONTROL    plat_air_control
+#endif
+
+#ifdef PLAT_CONST_TURN_CONTROL
+#define PLAT_TURN_CONTROL   PLAT_CONST_TURN_CONTROL
+#else
+#define PLAT_TURN_CONTROL   plat_turn_control
+#endif
+
+#ifdef PLAT_CONST_RUN_TYPE
+#define PLAT_RUN_TYPE       PLAT_CONST_RUN_TYPE
+#else
+#define PLAT_RUN_TYPE       plat_run_type
+#endif
+
+#ifdef PLAT_CONST_DASH
+#define PLAT_DASH           PLAT_CONST_DASH
+#else
+#define PLAT_DASH           plat_dash
+#endif
+
+#ifdef PLAT_CONST_DASH_STYLE
+#define PLAT_DASH_STYLE     PLAT_CONST_DASH_STYLE
+#else
+#define PLAT_DASH_STYLE     plat_dash_style
+#endif
+
+#ifdef PLAT_CONST_DASH_MOMENTUM
+#define PLAT_DASH_MOMENTUM  PLAT_CONST_DASH_MOMENTUM
+#else
+#define PLAT_DASH_MOMENTUM  plat_dash_momentum
+#endif
+
+#ifdef PLAT_CONST_DASH_THROUGH
+#define PLAT_DASH_THROUGH   PLAT_CONST_DASH_THROUGH
+#else
+#define PLAT_DASH_THROUGH   plat_dash_through
+#endif
+
+//True when a compile-time value isn't what the project settings put in its engine field. Fields without one always match.
+#define PLAT_CONST_MISMATCH() (plat_camera_block != PLAT_CAMERA_BLOCK \
+    || plat_drop_through != PLAT_DROP_THROUGH \
+    || plat_float_input != PLAT_FLOAT_INPUT \
+    || plat_wall_slide != PLAT_WALL_SLIDE \
+    || plat_air_control != PLAT_AIR_CONTROL \
+    || plat_turn_control != PLAT_TURN_CONTROL \
+    || plat_run_type != PLAT_RUN_TYPE \
+    || plat_dash != PLAT_DASH \
+    || plat_dash_style != PLAT_DASH_STYLE \
+    || plat_dash_momentum != PLAT_DASH_MOMENTUM \
+    || plat_dash_through != PLAT_DASH_THROUGH)
+
+#endif
@@ -0,0 +1,26 @@
+#pragma bank 255
+
+#include "pp_lag.h"
+
+UBYTE pp_lag_frames;
+UBYTE pp_shed;
+UBYTE pp_lag_time;          //Low byte of sys_time when the last frame was checked
+
+void pp_lag_reset() BANKED {
+    pp_lag_frames = 0;
+    pp_shed = 0;
+    pp_lag_time = (UBYTE)sys_time;
+}
+
+void pp_lag_update() BANKED {
+    //sys_time counts VBlanks, so any more than one since the last frame are frames that were lost
+    UBYTE now = (UBYTE)sys_time;
+    UBYTE lost = now - pp_lag_time - 1;
+    pp_lag_time = now;
+    if (lost != 0 && lost <= PP_LAG_MAX_LOST){
+        pp_lag_frames = (pp_lag_frames > 255 - lost) ? 255 : pp_lag_frames + lost;
+        pp_shed = PP_SHED_HOLD;
+    } else if (pp_shed != 0){
+        pp_shed--;
+    }
+}
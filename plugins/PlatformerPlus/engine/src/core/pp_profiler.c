@@ -0,0 +1,76 @@
+#pragma bank 255
+
+#include "pp_profiler.h"
+#include "vm.h"
+
+#ifdef PP_PROFILE
+
+#include <string.h>
+
+#include "math.h"
+
+pp_profile_zone_t pp_profile_zones[PP_ZONE_COUNT];
+UBYTE pp_profile_zone;      //Zone that is currently being timed, PP_ZONE_COUNT when none is open
+UBYTE pp_profile_start;     //DIV_REG when the open zone started
+UWORD pp_profile_frame;     //Ticks measured so far this frame
+
+void pp_profile_reset() BANKED {
+    memset(pp_profile_zones, 0, sizeof(pp_profile_zones));
+    for (UBYTE i = 0; i != PP_ZONE_COUNT; i++){
+        pp_profile_zones[i].min = 255;
+    }
+    pp_profile_zone = PP_ZONE_COUNT;
+    pp_profile_frame = 0;
+}
+
+static void pp_profile_record(pp_profile_zone_t *zone, UBYTE elapsed) NONBANKED {
+    if (elapsed < zone->min){
+        zone->min = elapsed;
+    }
+    if (elapsed > zone->max){
+        zone->max = elapsed;
+    }
+    zone->total += elapsed;
+    zone->samples += 1;
+    if (zone->samples == (1 << PP_PROFILE_SAMPLES_SHIFT)){
+        zone->avg = zone->total >> PP_PROFILE_SAMPLES_SHIFT;
+        zone->total = 0;
+        zone->samples = 0;
+    }
+}
+
+void pp_profile_end() NONBANKED {
+    //Read the timer first so the bookkeeping below isn't counted against the zone
+    UBYTE elapsed = DIV_REG - pp_profile_start;
+    if (pp_profile_zone == PP_ZONE_COUNT){
+        return;
+    }
+    pp_profile_record(&pp_profile_zones[pp_profile_zone], elapsed);
+    pp_profile_frame += elapsed;
+    pp_profile_zone = PP_ZONE_COUNT;
+}
+
+void pp_profile_begin(UBYTE zone) NONBANKED {
+    pp_profile_end();
+    if (zone == PP_ZONE_INPUT){
+        //platform_update() is the first timed zone of a frame, so the previous frame is complete
+        if (pp_profile_frame != 0){
+            pp_profile_record(&pp_profile_zones[PP_ZONE_FRAME], MIN(pp_profile_frame, 255));
+        }
+        pp_profile_frame = 0;
+    }
+    pp_profile_zone = zone;
+    pp_profile_start = DIV_REG;
+}
+
+#endif
+
+//Built with or without PP_PROFILE, so the Store Profiler Timing event always links. Without it every value reads as 0.
+void pp_profile_get(SCRIPT_CTX * THIS) OLDCALL BANKED {
+    UWORD *value = VM_REF_TO_PTR(FN_ARG0);     //Byte offset into pp_profile_zones on the way in, the value on the way out
+#ifdef PP_PROFILE
+    *value = (*value < sizeof(pp_profile_zones)) ? ((UBYTE *)pp_profile_zones)[*value] : 0;
+#else
+    *value = 0;
+#endif
+}
@@ -0,0 +1,124 @@
+#pragma bank 255
+
+#include "pp_recorder.h"
+
+#ifdef PP_RECORD
+
+#include "actor.h"
+#include "data_manager.h"
+#include "game_time.h"
+#include "input.h"
+
+#define PP_RECORD_SRAM ((UBYTE *)0xA000)
+
+UBYTE pp_record_started;    //Cleared on power-on, so each session starts a new recording
+UWORD pp_record_len;        //Bytes of data written so far
+UBYTE pp_record_joy;        //Input of the current run
+UBYTE pp_record_frames;     //Length of the current run, 0 if there isn't one
+UBYTE pp_record_full;       //Out of room: the recording stops rather than leave out a marker
+UBYTE pp_record_paused;     //The current run is of frames that didn't update the player
+UWORD pp_record_stepped;    //game_time of the last frame platform_update() ran in
+UBYTE pp_record_pending;    //pp_record_pending_joy still has to be written
+UBYTE pp_record_pending_joy;
+UWORD pp_record_pending_time;
+
+static UBYTE pp_record_room(UBYTE bytes) {
+    if (pp_record_len + bytes > PP_RECORD_SIZE - PP_RECORD_HEADER_SIZE) {
+        pp_record_full = TRUE;
+    }
+    return !pp_record_full;
+}
+
+static void pp_record_write(UBYTE value) {
+    PP_RECORD_SRAM[PP_RECORD_HEADER_SIZE + pp_record_len] = value;
+    pp_record_len++;
+}
+
+static void pp_record_close() {
+    PP_RECORD_SRAM[4] = (UBYTE)pp_record_len;
+    PP_RECORD_SRAM[5] = (UBYTE)(pp_record_len >> 8);
+    SWITCH_RAM(PP_RECORD_RESTORE_BANK);
+#if !PP_RECORD_RESTORE_ENABLED
+    DISABLE_RAM;
+#endif
+}
+
+static void pp_record_open() {
+    ENABLE_RAM;
+    SWITCH_RAM(PP_RECORD_SRAM_BANK);
+    if (!pp_record_started) {
+        PP_RECORD_SRAM[0] = 'P';
+        PP_RECORD_SRAM[1] = 'P';
+        PP_RECORD_SRAM[2] = 'R';
+        PP_RECORD_SRAM[3] = '2';
+        pp_record_len = 0;
+        pp_record_full = FALSE;
+        pp_record_paused = FALSE;
+        pp_record_pending = FALSE;
+        pp_record_stepped = game_time - 1;
+        pp_record_started = TRUE;
+    }
+}
+
+//Writes the frame held back by pp_record_input(). platform_update() has had its chance to run in that frame by now,
+//whichever order the engine calls it and actors_update() in.
+static void pp_record_flush() {
+    if (!pp_record_pending) {
+        return;
+    }
+    pp_record_pending = FALSE;
+    UBYTE paused = (pp_record_stepped != pp_record_pending_time);
+    if (paused != pp_record_paused) {
+        if (!pp_record_room(2)) {
+            return;
+        }
+        pp_record_write(paused ? PP_RECORD_MARK_PAUSED : PP_RECORD_MARK_RESUMED);
+        pp_record_write(0);
+        pp_record_paused = paused;
+        pp_record_frames = 0;
+    }
+    if (pp_record_frames != 0 && pp_record_pending_joy == pp_record_joy && pp_record_frames != 255) {
+        //Same input as last frame, so just lengthen the run that was already written
+        pp_record_frames++;
+        PP_RECORD_SRAM[PP_RECORD_HEADER_SIZE + pp_record_len - 1] = pp_record_frames;
+    } else if (pp_record_room(2)) {
+        pp_record_joy = pp_record_pending_joy;
+        pp_record_frames = 1;
+        pp_record_write(pp_record_joy);
+        pp_record_write(1);
+    }
+}
+
+void pp_record_scene() BANKED {
+    pp_record_open();
+    pp_record_flush();
+    if (!pp_record_room(9)) {
+        pp_record_close();
+        return;
+    }
+    pp_record_write(PP_RECORD_MARK_SCENE);
+    pp_record_write(0);
+    pp_record_write(current_scene.bank);
+    pp_record_write((UBYTE)(UWORD)current_scene.ptr);
+    pp_record_write((UBYTE)((UWORD)current_scene.ptr >> 8));
+    pp_record_write((UBYTE)PLAYER.pos.x);
+    pp_record_write((UBYTE)(PLAYER.pos.x >> 8));
+    pp_record_write((UBYTE)PLAYER.pos.y);
+    pp_record_write((UBYTE)(PLAYER.pos.y >> 8));
+    pp_record_frames = 0;
+    pp_record_close();
+}
+
+//Holds this frame's input back until the next call, and writes the one before it
+void pp_record_input() BANKED {
+    pp_record_open();
+    if (!pp_record_full) {
+        pp_record_flush();
+        pp_record_pending = TRUE;
+        pp_record_pending_joy = joy;
+        pp_record_pending_time = game_time;
+    }
+    pp_record_close();
+}
+
+#endif
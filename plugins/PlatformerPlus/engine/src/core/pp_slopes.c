@@ -0,0 +1,12 @@
+#include "pp_slopes.h"
+
+const UBYTE slope_surface[8][8] = {
+    {  0,   0,   0,   0,   0,   0,   0,   0},  //Not a slope
+    {112,  96,  80,  64,  48,  32,  16,   0},  //COLLISION_SLOPE_45_UP
+    {  0,  16,  32,  48,  64,  80,  96, 112},  //COLLISION_SLOPE_45_DOWN
+    {112, 112,  96,  96,  80,  80,  64,  64},  //COLLISION_SLOPE_22_UP_LOW
+    { 48,  48,  32,  32,  16,  16,   0,   0},  //COLLISION_SLOPE_22_UP_HIGH
+    {  0,   0,  16,  16,  32,  32,  48,  48},  //COLLISION_SLOPE_22_DOWN_HIGH
+    { 64,  64,  80,  80,  96,  96, 112, 112},  //COLLISION_SLOPE_22_DOWN_LOW
+    {  0,   0,   0,   0,   0,   0,   0,   0}
+};
@@ -2,9 +2,6 @@
 Future notes on things to do:
 - Limit air dashes before touching the ground
 - Add an option for wall jump that only allows alternating walls.
-- Currently, dashing through walls checks the potential end point, and if it isn't clear then it continues with the normal dash routine. 
-    The result is that there could be a valid landing point across a wall, but the player is just a little too close for it to register. 
-    I could create a 'look-back' loop that runs through the intervening tiles until it finds an empty landing spot.
 - The bounce event is a funny one, because it can have the player going up without being in the jump state. I should perhaps add some error catching stuff for such situations
 - Can I have a wall_jump init ahead of the normal jump init? If it's just checking a few more boxes....
 - Improve ladder situation: jump from ladder option, bug with hitting the bottom of ladders, other stuff?
@@ -21,7 +18,6 @@ Future notes on things to do:
 
 TARGETS for Optimization
 - State script assignment could be 100% be re-written to avoid all those assignments and directly use the pointers. I am not canny enough to do that.
-- I should be able to combine solid actors and platform actors into a single check...
 - It's inellegant that the dash check requires me to check again later if it succeeded or not. Can I reorganize this somehow?
 - I think I can probably combine actor_attached and last_actor
 - I need to refactor the downwards collision for Y, it's a bit of a mess at this point. I just can't wrap my head around it atm
@@ -41,6 +37,9 @@ The old format was well structured as a state-machine, isolating all the compone
 collision functions on the GameBoy makes this model unperformant. However, I'm also limited to the total amount of code that can be placed in a single bank. 
 I cannot get rid of the functions and move the code into the file itself. New structure is a compromise that uses goto commands to skip some sections that are
 shared by most of the states. 
+The helpers called every frame (basic_anim, wall_check, ladder_*, drop_press, tile_cache_update) are static so they stay in this
+bank and compile to near calls. Code that only runs on a state change, like dash_init_switch(), lives in platform_dash.c instead,
+which is autobanked and pays for its banked call only once per dash.
     
 INIT()
     Tweak a few fields so they don't overflow variables
@@ -66,13 +65,14 @@ UPDATE()
     G. Tic Counters                 gotoCounters
 
 
-BUGS:
- - When the player is on a moving platform and is hit by another one, they get caught mid-way on the next one.
 */
 #pragma bank 3
 
+#include <string.h>
+
 #include "data/states_defines.h"
 #include "states/platform.h"
+#include "states/platform_fields.h"
 
 #include "actor.h"
 #include "camera.h"
@@ -84,6 +84,27 @@ BUGS:
 #include "scroll.h"
 #include "trigger.h"
 #include "vm.h"
+#include "pp_profiler.h"
+#include "pp_recorder.h"
+#include "pp_lag.h"
+#include "pp_fixed.h"
+#include "pp_slopes.h"
+
+#ifdef STRICT
+    #include <gb/bgb_emu.h>
+    #include <gb/crash_handler.h>
+#endif
+
+//Helpers that only platform_update() uses. They share its bank, so they are plain near calls rather than BANKED ones.
+static void basic_anim();
+static void wall_check();
+static void ladder_check();
+static void ladder_switch();
+static void tile_cache_update();
+static void pl_box_update();
+static UBYTE actor_face(actor_t *actor);
+static UBYTE trigger_in_path(UBYTE tile_x, UBYTE len, BYTE step, UBYTE tile_start, UBYTE tile_end);
+static UBYTE drop_press();
 
 
 
@@ -100,8 +121,22 @@ BUGS:
 #define PLATFORM_CAMERA_DEADZONE_Y 16
 #endif
 
+//Most actors the player can be overlapping and still have resolved in one frame
+#define PLAT_MAX_ACTOR_HITS 4
+
+//How solid and platform actors collide with the player
+#define ACTOR_COL_TOP       0x01    //The player can land on the actor and ride it
+#define ACTOR_COL_SIDES     0x02    //The actor also blocks the player from below and from the sides
+
+//Face of an actor the player ran into, see actor_face()
+#define ACTOR_FACE_TOP      0
+#define ACTOR_FACE_BOTTOM   1
+#define ACTOR_FACE_LEFT     2
+#define ACTOR_FACE_RIGHT    3
+
 //TEST
-script_state_t state_events[21];
+script_state_t state_events[BLANK_STATE + 1];
+enum pStates script_state;  //State the state scripts last ran for, to catch entering and leaving states
 
 
 
@@ -150,32 +185,8 @@ UBYTE plat_dash_through;    //Choose if the player can dash through actors, trig
 WORD plat_dash_dist;        //Distance of the dash
 UBYTE plat_dash_frames;     //Number of frames for dashing
 UBYTE plat_dash_ready_max;  //Time before the player can dash again
-UBYTE plat_dash_deadzone;
-
-enum pStates {              //Datatype for tracking states
-    FALL_INIT = 0,
-    FALL_STATE,
-    FALL_END,
-    GROUND_INIT,
-    GROUND_STATE,
-    GROUND_END,
-    JUMP_INIT,
-    JUMP_STATE,
-    JUMP_END,
-    DASH_INIT,
-    DASH_STATE,
-    DASH_END,
-    LADDER_INIT,
-    LADDER_STATE,
-    LADDER_END,
-    WALL_INIT,
-    WALL_STATE,
-    WALL_END,
-    KNOCKBACK_INIT,
-    KNOCKBACK_STATE,
-    BLANK_INIT,
-    BLANK_STATE
-}; 
+UBYTE plat_dash_deadzone;   //Camera deadzone while dashing
+
 enum pStates plat_state;    //Current platformer state
 enum pStates que_state;
 UBYTE nocontrol_h;          //Turns off horizontal input, currently only for wall jumping
@@ -201,12 +212,53 @@ WORD dash_dist;             //Takes overall dash distance and holds the amount p
 UBYTE dash_currentframe;    //Tracks the current frame of the overall dash
 BYTE tap_val;               //Number of frames since the last time left or right button was tapped
 UBYTE dash_end_clear;       //Used to store the result of whether the end-position of a dash is empty
+UWORD dash_end_x;           //Where a dash through walls lands, which can be short of the full dash if the end was blocked
+
+//DASH WALL INDEX
+//Distance to the nearest wall ahead of the player, taken across every row the player occupies. It's built once when the
+//dash starts (or when the player changes row or direction mid-dash), so each dash frame only has to compare against it.
+UBYTE dash_wall_dist;       //Columns from dash_index_col to the first wall in the dash direction, DASH_NO_WALL if none
+UBYTE dash_index_col;       //Column the distance is measured from
+UBYTE dash_index_row;       //Top tile row of the player when the index was built
+UBYTE dash_index_row_end;   //Row below the player's bottom row when the index was built
+UBYTE dash_index_len;       //Number of columns that were scanned
+UBYTE dash_index_dir;       //Direction the index was built for
 
 //COLLISION VARS
 actor_t *last_actor;        //The last actor the player hit, and that they were attached to
 UBYTE actor_attached;       //Keeps track of whether the player is currently on an actor and inheriting its movement
-WORD mp_last_x;             //Keeps track of the pos.x of the attached actor from the previous frame
-WORD mp_last_y;             //Keeps track of the pos.y of the attached actor from the previous frame
+
+//COLLISION CACHE
+//Every collision check the player makes in a frame lands within a tile or two of their bounding box, and each tile_at() is a 
+//banked ROM read. Keep a copy of the surrounding tiles, and only read the new ones when the player crosses a tile boundary.
+UBYTE tile_cache[TILE_CACHE_H][TILE_CACHE_W];
+UBYTE tile_cache_x;         //Tile x-coord of the cache's left column (one tile left of the player)
+UBYTE tile_cache_y;         //Tile y-coord of the cache's top row (one tile above the player)
+
+//PLAYER HITBOX
+//PLAYER.bounds in subpixels, so that collisions can add them straight to a position instead of shifting it down to pixels
+//and back. Scripts can change the bounds at any time, so pl_box_update() rebuilds these whenever they differ from pl_box_bounds.
+bounding_box_t pl_box_bounds;   //The bounds the box was last built from
+WORD pl_box_left;
+WORD pl_box_right;
+WORD pl_box_top;
+WORD pl_box_bottom;
+WORD pl_box_mid;                //Middle of the player's feet, where slopes are checked
+UBYTE on_slope;                 //Slope bits of the tile the player is standing on, 0 when they aren't on a slope
+UWORD pl_last_x;                //Player's position at the start of the frame, to find which side of an actor they came from
+UWORD pl_last_y;
+
+//TRIGGER INDEX
+//trigger_activate_at_intersection() tests every trigger in the scene, so it's only called when the player's tile footprint
+//changes (or UP is pressed), and only near a tile column that has a trigger in it. The columns are indexed when the scene starts.
+const UBYTE trigger_col_bits[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+#define TRIGGER_COL(tx) (trigger_cols[(UBYTE)(tx) >> 3] & trigger_col_bits[(UBYTE)(tx) & 7])
+UBYTE trigger_cols[32];     //One bit per tile column, set if any trigger covers it
+UBYTE trigger_left;         //Player's tile footprint the last time triggers were checked
+UBYTE trigger_right;
+UBYTE trigger_top;
+UBYTE trigger_bottom;
+UBYTE trigger_near;         //The footprint was in an indexed column, so leaving it still needs a check
 
 
 //JUMPING VARIABLES
@@ -232,11 +284,19 @@ UBYTE jump_type;            //Tracks the type of jumping, from the ground, in th
 
 
 void platform_init() BANKED {
+#ifdef STRICT
+    //The engine fields are ignored once platform_fields.h gives them a value, so stop if the project settings have changed since
+    if (PLAT_CONST_MISMATCH()){
+        BGB_MESSAGE("Platformer+ settings don't match platform_fields.h\n");
+        __HandleCrash();
+    }
+#endif
     //Initialize Camera
     camera_offset_x = 0;
     camera_offset_y = 0;
     camera_deadzone_x = plat_camera_deadzone_x;
     camera_deadzone_y = PLATFORM_CAMERA_DEADZONE_Y;
+    camera_build_tables();
     if ((camera_settings & CAMERA_LOCK_X_FLAG)){
         camera_x = (PLAYER.pos.x >> 4) + 8;
     } else{
@@ -251,14 +311,14 @@ void platform_init() BANKED {
     //Initialize Camera Bounds
     mod_image_right = image_width - SCREEN_WIDTH;
     mod_image_left = 0;
-    if (plat_camera_block & 1){
+    if (PLAT_CAMERA_BLOCK & 1){
         edge_left = &scroll_x;
     }
     else{
         edge_left = &mod_image_left;
     }
 
-    if (plat_camera_block & 2){
+    if (PLAT_CAMERA_BLOCK & 2){
         edge_right = &scroll_x;
     }
     else{
@@ -289,6 +349,12 @@ void platform_init() BANKED {
     //Initialize State
     plat_state = GROUND_STATE;
     que_state = GROUND_STATE;
+    script_state = GROUND_STATE;
+    //State scripts stay attached between scenes, but their threads from the last scene are gone
+    for (UBYTE i = 0; i != BLANK_STATE + 1; i++){
+        state_events[i].script_thread = SCRIPT_TERMINATED;
+        state_events[i].script_timer = 0;
+    }
     actor_attached = FALSE;
     run_stage = 0;
     nocontrol_h = 0;
@@ -310,17 +376,49 @@ void platform_init() BANKED {
     deltaX = 0;
     deltaY = 0;
 
+    //Make sure the hitbox doesn't match, so that it's built from the current bounds
+    pl_box_bounds.left = PLAYER.bounds.left + 1;
+    pl_box_update();
+    on_slope = 0;
+
+    //Offset the collision cache from the player so that the first update reloads every tile
+    tile_cache_x = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_left) + 128;
+    tile_cache_y = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top) + 128;
+
+    //Index the columns that have triggers, and force a check on the first frame
+    memset(trigger_cols, 0, sizeof(trigger_cols));
+    for (UBYTE i = 0; i != triggers_len; i++){
+        UBYTE tx = triggers[i].x;
+        for (UBYTE w = triggers[i].width; w != 0; w--){
+            trigger_cols[tx >> 3] |= trigger_col_bits[tx & 7];
+            tx++;
+        }
+    }
+    trigger_left = 255;
+    trigger_near = TRUE;
+
+    pp_lag_reset();
+    PP_PROFILE_RESET();
+    PP_RECORD_SCENE();
 }
 
 void platform_update() BANKED {
     //INITIALIZE VARS
     WORD temp_y = 0;
     col = 0;                   //tracks if there is a block left or right
+    //The collision cache refresh is the biggest spike when the player crosses a tile, so it's timed with the input checks
+    PP_PROFILE_BEGIN(PP_ZONE_INPUT);
+    PP_RECORD_STEP();
+    pp_lag_update();
+    pl_box_update();
+    tile_cache_update();
+    pl_last_x = PLAYER.pos.x;
+    pl_last_y = PLAYER.pos.y;
     
     //A. INPUT CHECK=================================================================================================
     //Dash Input Check
     UBYTE dash_press = FALSE;
-    switch(plat_dash){
+    switch(PLAT_DASH){
         case 1:
             //Interact Dash
             if (INPUT_PRESSED(INPUT_PLATFORM_INTERACT)){
@@ -353,6 +451,7 @@ void platform_update() BANKED {
 
     // B. STATE MACHINE==================================================================================================
     // SWITCH that includes state initialization, calculation of horizontal motion and vertical Motion
+    PP_PROFILE_BEGIN(PP_ZONE_SWITCH1);
     plat_state = que_state;
     switch(plat_state){
         case FALL_INIT:
@@ -362,7 +461,7 @@ void platform_update() BANKED {
             
             //Vertical Movement--------------------------------------------------------------------------------------------
             //FLOAT INPUT
-            if (((plat_float_input == 1 && INPUT_PLATFORM_JUMP) || (plat_float_input == 2 && INPUT_UP)) && pl_vel_y >= 0){
+            if (((PLAT_FLOAT_INPUT == 1 && INPUT_PLATFORM_JUMP) || (PLAT_FLOAT_INPUT == 2 && INPUT_UP)) && pl_vel_y >= 0){
                 jump_type = 4;
                 pl_vel_y = plat_float_grav;
             } else if (nocollide != 0){
@@ -380,13 +479,12 @@ void platform_update() BANKED {
         
             //Collision ---------------------------------------------------------------------------------------------------
             //Vertical Collision Checks
-            deltaY += pl_vel_y >> 8;
-            temp_y = PLAYER.pos.y;    
+            deltaY += VEL_WHOLE(pl_vel_y);
 
             //Horizontal Movement----------------------------------------------------------------------------------------
-            if (nocontrol_h != 0 || plat_air_control == 0){
+            if (nocontrol_h != 0 || PLAT_AIR_CONTROL == 0){
                 //No horizontal input
-                deltaX += pl_vel_x >> 8;
+                deltaX += VEL_WHOLE(pl_vel_x);
                 goto gotoXCol;
             } 
         }
@@ -404,49 +502,33 @@ void platform_update() BANKED {
             
         case GROUND_STATE:{
                         
-            //Add X & Y motion from moving platforms
-            //Transform velocity into positional data, to keep the precision of the platform's movement
+            //Add X & Y motion from moving platforms. The platform's movement since last frame is kept in the player's slot of
+            //riders[], and is added to this frame's move so that the camera edges and tile collisions below apply to it.
             if (actor_attached){
-                //If the platform has been disabled, detach the player
-                if(last_actor->disabled == TRUE){
+                rider_t *ride = riders;
+                actor_t *platform = ride->platform;
+                //riders_update() empties the slot when the platform is disabled or the player is off its edges
+                if (!platform){
                     que_state = FALL_INIT;
                     actor_attached = FALSE;
-                //If the player is off the platform to the right, detach from the platform
-                } else if (PLAYER.pos.x + (PLAYER.bounds.left << 4) > last_actor->pos.x + 16 + (last_actor->bounds.right<< 4)) {
-                    que_state = FALL_INIT;
-                    actor_attached = FALSE;
-                //If the player is off the platform to the left, detach
-                } else if (PLAYER.pos.x + 16 + (PLAYER.bounds.right << 4) < last_actor->pos.x + (last_actor->bounds.left << 4)){
-                    que_state = FALL_INIT;
-                    actor_attached = FALSE;
-                } else{
-                //Otherwise, add any change in movement from platform
-                    deltaX += (last_actor->pos.x - mp_last_x);
-                    mp_last_x = last_actor->pos.x;
+                } else {
+                    //Otherwise, add any change in movement from the platform
+                    deltaX += platform->pos.x - ride->platform_last.x;
+                    deltaY += platform->pos.y - ride->platform_last.y;
+                    ride->platform_last = platform->pos;
                 }
-
                 //If we're on a platform, zero out any other motion from gravity or other sources
                 pl_vel_y = 0;
-                
-                //Add any change from the platform we're standing on
-                deltaY += last_actor->pos.y - mp_last_y;
-
-                //We're setting these to the platform's position, rather than the actor so that if something causes the player to
-                //detach (like hitting the roof), they won't automatically get re-attached in the subsequent actor collision step.
-                mp_last_y = last_actor->pos.y;
-                temp_y = last_actor->pos.y;
             } else if (nocollide != 0){
                 //If we're dropping through a platform
                 pl_vel_y = 7000; //magic number, rough minimum for actually having the player descend through a platform
-                temp_y = PLAYER.pos.y;
             } else {
                 //Normal gravity
                 pl_vel_y += plat_grav;
-                temp_y = PLAYER.pos.y;
                 que_state = FALL_INIT; //Use this to test for Falling, avoids an If test in YCollision
             }
             // Add Collision Offset from Moving Platforms
-            deltaY += pl_vel_y >> 8;
+            deltaY += VEL_WHOLE(pl_vel_y);
 
         }
         break;
@@ -475,7 +557,7 @@ void platform_update() BANKED {
                     pl_vel_y = 0;
                 }
                 //Add jump boost from horizontal movement
-                WORD tempBoost = (pl_vel_x >> 8) * boost_val;
+                WORD tempBoost = VEL_WHOLE(pl_vel_x) * boost_val;
                 //Take the positive value of x-vel
                 tempBoost = MAX(tempBoost, -tempBoost);
                 //This is a test to see if the results will overflow pl_vel_y. Note, pl_vel_y is negative here.
@@ -496,14 +578,13 @@ void platform_update() BANKED {
                 pl_vel_y += plat_grav;
             }
 
-            temp_y = PLAYER.pos.y;
             //Start DeltaX with Actor offsets
-            deltaY += pl_vel_y >> 8;
+            deltaY += VEL_WHOLE(pl_vel_y);
 
             //Horizontal Movement-----------------------------------------------------------------------------------------
-            if (nocontrol_h != 0 || plat_air_control == 0){
+            if (nocontrol_h != 0 || PLAT_AIR_CONTROL == 0){
                 //If the player doesn't have control of their horizontal movement, skip acceleration phase
-                deltaX += pl_vel_x >> 8;
+                deltaX += VEL_WHOLE(pl_vel_x);
                 goto gotoXCol;
             } 
         }
@@ -517,55 +598,74 @@ void platform_update() BANKED {
             //Movement & Collision Combined----------------------------------------------------------------------------------
             //Dashing uses much of the basic collision code. Comments here focus on the differences.
             UBYTE tile_current; //For tracking collisions across longer distances
-            UBYTE tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top)    >> 3);
-            UBYTE tile_end   = (((PLAYER.pos.y >> 4) + PLAYER.bounds.bottom) >> 3) + 1;        
+            UBYTE tile_start = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top);
+            UBYTE tile_end   = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom) + 1;
+            UBYTE camera_stop;  //Columns the player can travel before the camera edge stops the dash
+            UBYTE wall_stop;    //Columns the player can travel before hitting a wall
+            UBYTE trigger_stop = 255;   //Columns the player can travel before reaching a trigger
             col = 0;
 
             //Right Dash Movement & Collision
             if (PLAYER.dir == DIR_RIGHT){
                 //Get tile x-coord of player position
-                tile_current = ((PLAYER.pos.x >> 4) + PLAYER.bounds.right) >> 3;
+                tile_current = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_right);
                 //Get tile x-coord of final position
                 UWORD new_x = PLAYER.pos.x + (dash_dist);
-                UBYTE tile_x = (((new_x >> 4) + PLAYER.bounds.right) >> 3) + 1;
-                //check each space from the start of the dash until the end of the dash.
-                //in the future, I should build a reversed version of this section for dashing through walls.
-                //However, it's not quite as simple as reversing the direction of the check. The loops need to store the player's width and only return when there are enough spaces in a row
-                while (tile_current != tile_x){
-                    //Don't go past camera bounds
-                    if ((plat_camera_block & 2) && tile_current > (camera_x + SCREEN_WIDTH_HALF - 16) >> 3){
-                        new_x = ((((tile_current) << 3) - PLAYER.bounds.right) << 4) -1;
-                        dash_currentframe == 0;
-                        goto endRcol;
+                UBYTE tile_x = SUBPX_TO_TILE(new_x + pl_box_right);
+                UBYTE span;
+                //A dash through walls stops at the landing spot it found
+                if (PLAT_DASH_THROUGH == 3 && dash_end_clear && new_x >= dash_end_x){
+                    new_x = dash_end_x;
+                    tile_x = SUBPX_TO_TILE(new_x + pl_box_right);
+                    dash_currentframe = 0;
+                }
+                span = tile_x - tile_current;
+                camera_stop = 255;
+                wall_stop = 255;
+
+                //Don't go past camera bounds
+                if (PLAT_CAMERA_BLOCK & 2){
+                    WORD camera_tile = (camera_x + SCREEN_WIDTH_HALF - 16) >> 3;
+                    if (tile_current > camera_tile){
+                        camera_stop = 0;
+                    } else if (tile_x > camera_tile){
+                        camera_stop = camera_tile + 1 - tile_current;
                     }
-                        //CHECK TOP AND BOTTOM
-                    while (tile_start != tile_end) {
-                        //Check for Collisions (if the player collides with walls)
-                        if(plat_dash_through != 3 || dash_end_clear == FALSE){                    
-                            if (tile_at(tile_current, tile_start) & COLLISION_LEFT) {
-                                //The landing space is the tile we collided on, but one to the left
-                                new_x = ((((tile_current) << 3) - PLAYER.bounds.right) << 4) -1;
-                                col = 1;
-                                last_wall = 1;
-                                wc_val = plat_coyote_max;
-                                dash_currentframe == 0;
-                                goto endRcol;
-                            }   
-                        }
-                        //Check for Triggers at each step. If there is a trigger stop the dash (but don't run the trigger yet).
-                        /*if (plat_dash_through < 2){
-                            if (trigger_at_tile(tile_current, tile_start) != NO_TRIGGER_COLLISON) {
-                                new_x = ((((tile_current+1) << 3) - PLAYER.bounds.right) << 4);
-                            }
-                        }*/
-                        tile_start++;
+                }
+                //Check for Collisions (if the player collides with walls). The wall index turns the sweep over every tile 
+                //between here and the end of this frame's dash into a single comparison.
+                if(PLAT_DASH_THROUGH != 3 || dash_end_clear == FALSE){
+                    UBYTE offset = tile_current - dash_index_col;
+                    if (dash_index_dir != DIR_RIGHT || dash_index_row != tile_start || dash_index_row_end != tile_end || dash_wall_dist < offset || offset + span >= dash_index_len){
+                        dash_index_build(tile_current, span + 1 + ((dash_dist * dash_currentframe) >> 7));
+                        offset = 0;
                     }
-                    
-                    tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top) >> 3);
-                    tile_current += 1;
+                    if (dash_wall_dist <= offset + span){
+                        wall_stop = dash_wall_dist - offset;
+                    }
+                }
+                //Check for Triggers at each step. If there is a trigger stop the dash in its first column (but don't run the trigger yet).
+                if (PLAT_DASH_THROUGH < 2){
+                    trigger_stop = trigger_in_path(tile_current, span, 1, tile_start, tile_end);
                 }
-                endRcol: 
-                if(plat_dash_momentum == 1 || plat_dash_momentum == 3){           
+
+                if (trigger_stop < wall_stop && trigger_stop < camera_stop){
+                    new_x = TILE_TO_SUBPX((UBYTE)(tile_current + trigger_stop)) - pl_box_right;
+                    dash_currentframe = 0;
+                //The camera edge wins if it comes first (or in the same column)
+                } else if (camera_stop <= wall_stop && camera_stop != 255){
+                    new_x = TILE_TO_SUBPX((UBYTE)(tile_current + camera_stop)) - pl_box_right - 1;
+                    dash_currentframe = 0;
+                } else if (wall_stop != 255){
+                    //The landing space is the tile we collided on, but one to the left
+                    new_x = TILE_TO_SUBPX((UBYTE)(tile_current + wall_stop)) - pl_box_right - 1;
+                    col = 1;
+                    last_wall = 1;
+                    wc_val = plat_coyote_max;
+                    dash_currentframe = 0;
+                }
+
+                if(PLAT_DASH_MOMENTUM == 1 || PLAT_DASH_MOMENTUM == 3){           
                     //Dashes don't actually use velocity, so we will simulate the momentum by adding the full run speed. 
                     pl_vel_x = plat_run_vel;
                 } else{
@@ -577,45 +677,60 @@ void platform_update() BANKED {
             //Left Dash Movement & Collision
             else if (PLAYER.dir == DIR_LEFT){
                 //Get tile x-coord of player position
-                tile_current = ((PLAYER.pos.x >> 4) + PLAYER.bounds.left) >> 3;
+                tile_current = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_left);
                 //Get tile x-coord of final position
                 WORD new_x = PLAYER.pos.x - (dash_dist);
-                UBYTE tile_x = (((new_x >> 4) + PLAYER.bounds.left) >> 3)-1;
-                //CHECK EACH SPACE FROM START TO END
-                while (tile_current != tile_x){
-                    //Camera lock check
-                    if ((plat_camera_block & 1) && tile_current < (camera_x - SCREEN_WIDTH_HALF) >> 3){
-                        new_x = ((((tile_current + 1) << 3) - PLAYER.bounds.left) << 4)+1;
-                        dash_currentframe == 0;
-                        goto endLcol;
+                UBYTE tile_x = SUBPX_TO_TILE(new_x + pl_box_left);
+                UBYTE span;
+                if (PLAT_DASH_THROUGH == 3 && dash_end_clear && new_x <= (WORD)dash_end_x){
+                    new_x = dash_end_x;
+                    tile_x = SUBPX_TO_TILE(new_x + pl_box_left);
+                    dash_currentframe = 0;
+                }
+                span = tile_current - tile_x;
+                camera_stop = 255;
+                wall_stop = 255;
+
+                //Camera lock check
+                if (PLAT_CAMERA_BLOCK & 1){
+                    WORD camera_tile = (camera_x - SCREEN_WIDTH_HALF) >> 3;
+                    if (tile_current < camera_tile){
+                        camera_stop = 0;
+                    } else if (span > tile_current - camera_tile){
+                        camera_stop = tile_current - camera_tile + 1;
                     }
-                    //CHECK TOP AND BOTTOM
-                    while (tile_start != tile_end) {   
-                        //check for walls
-                        if(plat_dash_through != 3 || dash_end_clear == FALSE){  //If you collide with walls
-                            if (tile_at(tile_current, tile_start) & COLLISION_RIGHT) {
-                                new_x = ((((tile_current + 1) << 3) - PLAYER.bounds.left) << 4)+1;
-                                col = -1;
-                                last_wall = -1;
-                                dash_currentframe == 0;
-                                wc_val = plat_coyote_max;
-                                goto endLcol;
-                            }
-                        }
-                        //Check for triggers
-                        /*if (plat_dash_through  < 2){
-                            if (trigger_at_tile(tile_current, tile_start) != NO_TRIGGER_COLLISON) {
-                                new_x = ((((tile_current - 1) << 3) - PLAYER.bounds.left) << 4);
-                                goto endLcol;
-                            }
-                        }*/  
-                        tile_start++;
+                }
+                //check for walls
+                if(PLAT_DASH_THROUGH != 3 || dash_end_clear == FALSE){  //If you collide with walls
+                    UBYTE offset = dash_index_col - tile_current;
+                    if (dash_index_dir != DIR_LEFT || dash_index_row != tile_start || dash_index_row_end != tile_end || dash_wall_dist < offset || offset + span >= dash_index_len){
+                        dash_index_build(tile_current, span + 1 + ((dash_dist * dash_currentframe) >> 7));
+                        offset = 0;
+                    }
+                    if (dash_wall_dist <= offset + span){
+                        wall_stop = dash_wall_dist - offset;
                     }
-                    tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top) >> 3);
-                    tile_current -= 1;
                 }
-                endLcol: 
-                if(plat_dash_momentum == 1 || plat_dash_momentum == 3){            
+                //Check for triggers
+                if (PLAT_DASH_THROUGH < 2){
+                    trigger_stop = trigger_in_path(tile_current, span, -1, tile_start, tile_end);
+                }
+
+                if (trigger_stop < wall_stop && trigger_stop < camera_stop){
+                    new_x = TILE_TO_SUBPX((UBYTE)(tile_current - trigger_stop + 1)) - pl_box_left - 1;
+                    dash_currentframe = 0;
+                } else if (camera_stop <= wall_stop && camera_stop != 255){
+                    new_x = TILE_TO_SUBPX((UBYTE)(tile_current - camera_stop + 1)) - pl_box_left + 1;
+                    dash_currentframe = 0;
+                } else if (wall_stop != 255){
+                    new_x = TILE_TO_SUBPX((UBYTE)(tile_current - wall_stop + 1)) - pl_box_left + 1;
+                    col = -1;
+                    last_wall = -1;
+                    dash_currentframe = 0;
+                    wc_val = plat_coyote_max;
+                }
+
+                if(PLAT_DASH_MOMENTUM == 1 || PLAT_DASH_MOMENTUM == 3){            
                     pl_vel_x = -plat_run_vel;
                 } else{
                     pl_vel_x = 0;
@@ -624,7 +739,7 @@ void platform_update() BANKED {
             }
 
             //Vertical Movement & Collision-------------------------------------------------------------------------
-            if(plat_dash_momentum >= 2){
+            if(PLAT_DASH_MOMENTUM >= 2){
                 //If we're using vertical momentum, add gravity as normal (otherwise, vel_y = 0)
                 pl_vel_y += plat_hold_grav;
 
@@ -651,20 +766,37 @@ void platform_update() BANKED {
                 } 
 
                 //Vertical Collisions
-                temp_y = PLAYER.pos.y;    
-                deltaY += pl_vel_y >> 8;
+                deltaY += VEL_WHOLE(pl_vel_y);
                 deltaY = CLAMP(deltaY, -127, 127);
-                UBYTE tile_start = (((PLAYER.pos.x >> 4) + PLAYER.bounds.left)  >> 3);
-                UBYTE tile_end   = (((PLAYER.pos.x >> 4) + PLAYER.bounds.right) >> 3) + 1;
+                UBYTE tile_start = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_left);
+                UBYTE tile_end   = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_right) + 1;
                 if (deltaY > 0) {
 
                 //Moving Downward
                     WORD new_y = PLAYER.pos.y + deltaY;
-                    UBYTE tile_y = ((new_y >> 4) + PLAYER.bounds.bottom) >> 3;
+                    UBYTE tile_y = SUBPX_TO_TILE(new_y + pl_box_bottom);
+                    //Land on a slope under the middle of the player's feet, or on one sitting on the floor they reached, as in gotoYCol
+                    UWORD foot_x = PLAYER.pos.x + pl_box_mid;
+                    UBYTE foot_tx = SUBPX_TO_TILE(foot_x);
+                    UBYTE slope_ty = tile_y;
+                    UBYTE slope_tile = cached_tile_at(foot_tx, slope_ty);
+                    if (!(slope_tile & COLLISION_SLOPE) && (slope_tile & COLLISION_TOP)){
+                        slope_ty--;
+                        slope_tile = cached_tile_at(foot_tx, slope_ty);
+                    }
+                    if (slope_tile & COLLISION_SLOPE){
+                        WORD slope_y = TILE_TO_SUBPX(slope_ty) + SLOPE_SURFACE(slope_tile, SUBPX_TILE_PX(foot_x)) - pl_box_bottom - 1;
+                        if (new_y >= slope_y){
+                            new_y = slope_y;
+                            actor_attached = FALSE;
+                            pl_vel_y = 256;
+                        }
+                        tile_start = tile_end;
+                    }
                     while (tile_start != tile_end) {
-                        if (tile_at(tile_start, tile_y) & COLLISION_TOP) {                    
+                        if (cached_tile_at(tile_start, tile_y) & COLLISION_TOP) {
                             //Land on Floor
-                            new_y = ((((tile_y) << 3) - PLAYER.bounds.bottom) << 4) - 1;
+                            new_y = TILE_TO_SUBPX(tile_y) - pl_box_bottom - 1;
                             actor_attached = FALSE; //Detach when MP moves through a solid tile.                                   
                             pl_vel_y = 256;
                             break;
@@ -676,10 +808,10 @@ void platform_update() BANKED {
 
                     //Moving Upward
                     WORD new_y = PLAYER.pos.y + deltaY;
-                    UBYTE tile_y = (((new_y >> 4) + PLAYER.bounds.top) >> 3);
+                    UBYTE tile_y = SUBPX_TO_TILE(new_y + pl_box_top);
                     while (tile_start != tile_end) {
-                        if (tile_at(tile_start, tile_y) & COLLISION_BOTTOM) {
-                            new_y = ((((UBYTE)(tile_y + 1) << 3) - PLAYER.bounds.top) << 4) + 1;
+                        if (cached_tile_at(tile_start, tile_y) & COLLISION_BOTTOM) {
+                            new_y = TILE_TO_SUBPX((UBYTE)(tile_y + 1)) - pl_box_top + 1;
                             pl_vel_y = 0;
                             break;
                         }
@@ -689,13 +821,11 @@ void platform_update() BANKED {
                 }
                 // Clamp Y Velocity
                 pl_vel_y = CLAMP(pl_vel_y,-plat_max_fall_vel, plat_max_fall_vel);
-            } else{
-                temp_y = PLAYER.pos.y;  
             }
         
         }
                 //CHECKS-------------------------------------------------------------------------------------------------------
-        if (plat_dash_through >= 1){
+        if (PLAT_DASH_THROUGH >= 1){
             goto gotoSwitch2;
         }
         goto gotoActorCol;
@@ -720,7 +850,7 @@ void platform_update() BANKED {
             } else if (pl_vel_y < 0){
                 //If the player is still ascending, don't apply wall-gravity
                 pl_vel_y += plat_grav;
-            } else if (plat_wall_slide) {
+            } else if (PLAT_WALL_SLIDE) {
                 //If the toggle is on, use wall gravity
                 pl_vel_y = plat_wall_grav;
             } else{
@@ -730,8 +860,7 @@ void platform_update() BANKED {
 
             //Collision--------------------------------------------------------------------------------------------------
             //Vertical Collision Checks
-            deltaY += pl_vel_y >> 8;
-            temp_y = PLAYER.pos.y;    
+            deltaY += VEL_WHOLE(pl_vel_y);
         }
         break;
     //================================================================================================================
@@ -748,7 +877,7 @@ void platform_update() BANKED {
                     pl_vel_x -= plat_air_dec;
                     pl_vel_x = MAX(pl_vel_x, 0);
             }
-            deltaX += pl_vel_x >> 8;
+            deltaX += VEL_WHOLE(pl_vel_x);
         
             //Vertical Movement--------------------------------------------------------------------------------------------
             //Normal gravity
@@ -759,8 +888,7 @@ void platform_update() BANKED {
 
 
             //Vertical Collision Checks
-            deltaY += pl_vel_y >> 8;
-            temp_y = PLAYER.pos.y;    
+            deltaY += VEL_WHOLE(pl_vel_y);
 
             nocollide = 0;
         }
@@ -787,7 +915,7 @@ void platform_update() BANKED {
         }
 
         if (INPUT_PLATFORM_RUN){
-            switch(plat_run_type){
+            switch(PLAT_RUN_TYPE){
                 case 0:
                 //Ordinay Walk (same as below). I can't think of a way to collapse these two uses.
                     if(pl_vel_x < 0 && plat_turn_acc != 0){
@@ -798,14 +926,14 @@ void platform_update() BANKED {
                         pl_vel_x = CLAMP(pl_vel_x + plat_walk_acc, plat_min_vel, plat_walk_vel); 
                     }
                     pl_vel_x *= dir;
-                    deltaX += pl_vel_x >> 8;
+                    deltaX += VEL_WHOLE(pl_vel_x);
                     
                 break;
                 case 1:
                 //Type 1: Smooth Acceleration as the Default in GBStudio
                     pl_vel_x = CLAMP(pl_vel_x + plat_run_acc, plat_min_vel, plat_run_vel);
                     pl_vel_x *= dir;
-                    deltaX += pl_vel_x >> 8;
+                    deltaX += VEL_WHOLE(pl_vel_x);
                     run_stage = 1;
                 break;
                 case 2:
@@ -823,13 +951,13 @@ void platform_update() BANKED {
                         run_stage = 2;
                     }
                     pl_vel_x *= dir;
-                    deltaX += pl_vel_x >> 8;
+                    deltaX += VEL_WHOLE(pl_vel_x);
                 break;
                 case 3:
                 //Type 3: Instant acceleration to full speed
                     run_stage = 1;
                     pl_vel_x = plat_run_vel * dir;
-                    deltaX += pl_vel_x >> 8;
+                    deltaX += VEL_WHOLE(pl_vel_x);
                 break;
                 case 4:
                 //Type 4: Tiered acceleration with 2 speeds
@@ -854,7 +982,7 @@ void platform_update() BANKED {
                         run_stage = 3;
                     }
                     pl_vel_x *= dir;
-                    deltaX += pl_vel_x >> 8;
+                    deltaX += VEL_WHOLE(pl_vel_x);
                 break;
                 case 5:
                     //Type 4: Tiered acceleration with 3 speeds. Midspeed calc is a bit annoying.
@@ -887,7 +1015,7 @@ void platform_update() BANKED {
                         run_stage = 4;
                     }
                     pl_vel_x *= dir;
-                    deltaX += pl_vel_x >> 8;
+                    deltaX += VEL_WHOLE(pl_vel_x);
                     break;
             }
         } else {
@@ -901,7 +1029,7 @@ void platform_update() BANKED {
                 pl_vel_x = CLAMP(pl_vel_x, plat_min_vel, plat_walk_vel); 
             }
             pl_vel_x *= dir;
-            deltaX += pl_vel_x >> 8;
+            deltaX += VEL_WHOLE(pl_vel_x);
 
         }
     } else{
@@ -927,15 +1055,20 @@ void platform_update() BANKED {
             }
         }
         run_stage = 0;
-        deltaX += pl_vel_x >> 8;
+        deltaX += VEL_WHOLE(pl_vel_x);
     }
 
     //FUNCTION X COLLISION
     gotoXCol:
+    PP_PROFILE_BEGIN(PP_ZONE_XCOL);
     {
         deltaX = CLAMP(deltaX, -127, 127);
-        UBYTE tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top)    >> 3);
-        UBYTE tile_end   = (((PLAYER.pos.y >> 4) + PLAYER.bounds.bottom) >> 3) + 1;       
+        //Don't let a move wrap past the left side of the scene
+        if (deltaX < 0 && PLAYER.pos.x < (UWORD)(-deltaX)){
+            deltaX = -PLAYER.pos.x;
+        }
+        UBYTE tile_start = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top);
+        UBYTE tile_end   = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom) + 1;
         UWORD new_x = PLAYER.pos.x + deltaX;
         
         //Edge Locking
@@ -959,12 +1092,20 @@ void platform_update() BANKED {
             }
         }
 
+        //On the ground, the tile a slope rises onto isn't a wall in the row of the player's feet. The front of the player
+        //reaches it while the middle of their feet is still on the slope, or on the flat just before it.
+        UBYTE tile_mid = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_mid);
+        UBYTE slope_check = on_slope || plat_state == GROUND_STATE;
+
         //Step-Check for collisions one tile left or right for each avatar height tile
         if (new_x > PLAYER.pos.x) {
-            UBYTE tile_x = ((new_x >> 4) + PLAYER.bounds.right) >> 3;
+            UBYTE tile_x = SUBPX_TO_TILE(new_x + pl_box_right);
+            if (slope_check && (SLOPE_RISES_RIGHT(cached_tile_at(tile_mid, tile_end - 1)) || SLOPE_RISES_RIGHT(cached_tile_at(tile_x - 1, tile_end - 1)))){
+                tile_end--;
+            }
             while (tile_start != tile_end) {
-                if (tile_at(tile_x, tile_start) & COLLISION_LEFT) {
-                    new_x = (((tile_x << 3) - PLAYER.bounds.right) << 4) - 1;
+                if (cached_tile_at(tile_x, tile_start) & COLLISION_LEFT) {
+                    new_x = TILE_TO_SUBPX(tile_x) - pl_box_right - 1;
                     pl_vel_x = 0;
                     col = 1;
                     last_wall = 1;
@@ -974,10 +1115,13 @@ void platform_update() BANKED {
                 tile_start++;
             }
         } else if (new_x < PLAYER.pos.x) {
-            UBYTE tile_x = ((new_x >> 4) + PLAYER.bounds.left) >> 3;
+            UBYTE tile_x = SUBPX_TO_TILE(new_x + pl_box_left);
+            if (slope_check && (SLOPE_RISES_LEFT(cached_tile_at(tile_mid, tile_end - 1)) || SLOPE_RISES_LEFT(cached_tile_at(tile_x + 1, tile_end - 1)))){
+                tile_end--;
+            }
             while (tile_start != tile_end) {
-                if (tile_at(tile_x, tile_start) & COLLISION_RIGHT) {
-                    new_x = ((((tile_x + 1) << 3) - PLAYER.bounds.left) << 4) + 1;
+                if (cached_tile_at(tile_x, tile_start) & COLLISION_RIGHT) {
+                    new_x = TILE_TO_SUBPX(tile_x + 1) - pl_box_left + 1;
                     pl_vel_x = 0;
                     col = -1;
                     last_wall = -1;
@@ -991,24 +1135,54 @@ void platform_update() BANKED {
     }
 
     gotoYCol:
+    PP_PROFILE_BEGIN(PP_ZONE_YCOL);
     {
         //FUNCTION Y COLLISION
         deltaY = CLAMP(deltaY, -127, 127);
-        UBYTE tile_start = (((PLAYER.pos.x >> 4) + PLAYER.bounds.left)  >> 3);
-        UBYTE tile_end   = (((PLAYER.pos.x >> 4) + PLAYER.bounds.right) >> 3) + 1;
+        UBYTE was_on_slope = on_slope;
+        on_slope = 0;
+        UBYTE tile_start = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_left);
+        UBYTE tile_end   = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_right) + 1;
         if (deltaY > 0) {
             //Moving Downward
             WORD new_y = PLAYER.pos.y + deltaY;
-            UBYTE tile_y = ((new_y >> 4) + PLAYER.bounds.bottom) >> 3;
+            UBYTE tile_y = SUBPX_TO_TILE(new_y + pl_box_bottom);
             if (nocollide == 0){
+                //Slopes are only checked under the middle of the player's feet. If that tile is solid, check the one above it
+                //in case the player is walking up a slope, and if it's empty while they're on a slope, check below to follow
+                //it down. A player walking off a ledge above a slope falls onto it instead.
+                UWORD foot_x = PLAYER.pos.x + pl_box_mid;
+                UBYTE foot_tx = SUBPX_TO_TILE(foot_x);
+                UBYTE slope_ty = tile_y;
+                UBYTE slope_tile = cached_tile_at(foot_tx, slope_ty);
+                if (!(slope_tile & COLLISION_SLOPE)){
+                    if (slope_tile & COLLISION_TOP){
+                        slope_ty--;
+                        slope_tile = cached_tile_at(foot_tx, slope_ty);
+                    } else if (plat_state == GROUND_STATE && was_on_slope){
+                        slope_ty++;
+                        slope_tile = cached_tile_at(foot_tx, slope_ty);
+                    }
+                }
+                if (slope_tile & COLLISION_SLOPE){
+                    WORD slope_y = TILE_TO_SUBPX(slope_ty) + SLOPE_SURFACE(slope_tile, SUBPX_TILE_PX(foot_x)) - pl_box_bottom - 1;
+                    //On the ground, stick to the slope while already on one, or when stepping onto it from the flat in the same row
+                    if (new_y >= slope_y || (plat_state == GROUND_STATE && (was_on_slope || slope_ty == tile_y))){
+                        new_y = slope_y;
+                        on_slope = slope_tile & COLLISION_SLOPE;
+                        goto slope_land;
+                    }
+                    //Above the surface of the slope, the square tiles around it don't count
+                    tile_start = tile_end;
+                }
                 //Check collisions from left to right with the bottom of the player
                 while (tile_start != tile_end) {
-                    if (tile_at(tile_start, tile_y) & COLLISION_TOP) {
+                    if (cached_tile_at(tile_start, tile_y) & COLLISION_TOP) {
                         //Drop-Through Floor Check 
                         if (drop_press()){
                             //If it's a regular tile, do not drop through
                             while (tile_start != tile_end) {
-                                if (tile_at(tile_start, tile_y) & COLLISION_BOTTOM){
+                                if (cached_tile_at(tile_start, tile_y) & COLLISION_BOTTOM){
                                     //Escape two levels of looping.
                                     goto land;
                                 }
@@ -1020,7 +1194,8 @@ void platform_update() BANKED {
                         }
                         //Land on Floor
                         land:
-                        new_y = ((((tile_y) << 3) - PLAYER.bounds.bottom) << 4) - 1;
+                        new_y = TILE_TO_SUBPX(tile_y) - pl_box_bottom - 1;
+                        slope_land:
                         actor_attached = FALSE; //Detach when MP moves through a solid tile.
                         //The distinction here is used so that we can check the velocity when the player hits the ground.
                         if(plat_state == GROUND_STATE){
@@ -1039,10 +1214,10 @@ void platform_update() BANKED {
         } else if (deltaY < 0) {
             //Moving Upward
             WORD new_y = PLAYER.pos.y + deltaY;
-            UBYTE tile_y = (((new_y >> 4) + PLAYER.bounds.top) >> 3);
+            UBYTE tile_y = SUBPX_TO_TILE(new_y + pl_box_top);
             while (tile_start != tile_end) {
-                if (tile_at(tile_start, tile_y) & COLLISION_BOTTOM) {
-                    new_y = ((((UBYTE)(tile_y + 1) << 3) - PLAYER.bounds.top) << 4) + 1;
+                if (cached_tile_at(tile_start, tile_y) & COLLISION_BOTTOM) {
+                    new_y = TILE_TO_SUBPX((UBYTE)(tile_y + 1)) - pl_box_top + 1;
                     pl_vel_y = 0;
                     //MP Test: Attempting stuff to stop the player from continuing upward
                     if(actor_attached){
@@ -1065,83 +1240,92 @@ void platform_update() BANKED {
     //FUNCTION ACTOR CHECK
     //Actor Collisions
     gotoActorCol:
+    PP_PROFILE_BEGIN(PP_ZONE_ACTORCOL);
     {
         deltaX = 0;
         deltaY = 0;
-        actor_t *hit_actor;
-        hit_actor = actor_overlapping_player(FALSE);
-        if (hit_actor != NULL && hit_actor->collision_group) {
-            //Solid Actors
+        actor_t *hits[PLAT_MAX_ACTOR_HITS];
+        actor_t *register_actor = NULL;     //Actor that gets the player's hit scripts this frame
+        actor_t *talk_actor = NULL;         //First overlapping actor without a collision group
+        UBYTE hit_count = actors_overlapping_player(hits, PLAT_MAX_ACTOR_HITS, FALSE);
+        //Resolve every overlapping actor, so that a second platform or an enemy isn't missed behind the first hit
+        for (UBYTE i = 0; i != hit_count; i++){
+            actor_t *hit_actor = hits[i];
+            if (!hit_actor->collision_group){
+                if (!talk_actor){
+                    talk_actor = hit_actor;
+                }
+                continue;
+            }
+            //Solid and platform actors share one resolver: both can be landed on, but only solid actors block the rest
+            UBYTE actor_flags;
             if (hit_actor->collision_group == plat_solid_group){
-                if(!actor_attached || hit_actor != last_actor){
-                    if (temp_y < (hit_actor->pos.y + (hit_actor->bounds.top << 4)) && pl_vel_y >= 0){
-                        //Attach to MP
-                        last_actor = hit_actor;
-                        mp_last_x = hit_actor->pos.x;
-                        mp_last_y = hit_actor->pos.y;
-                        PLAYER.pos.y = hit_actor->pos.y + (hit_actor->bounds.top << 4) - (PLAYER.bounds.bottom << 4) - 4;
-                        //Other cleanup
-                        pl_vel_y = 0;
-                        actor_attached = TRUE;                        
-                        que_state = GROUND_INIT;
-                        //PLAYER bounds top seems to be 0 and counting down...
-                    } else if (temp_y + (PLAYER.bounds.top << 4) > hit_actor->pos.y + (hit_actor->bounds.bottom<<4)){
+                actor_flags = ACTOR_COL_TOP | ACTOR_COL_SIDES;
+            } else if (hit_actor->collision_group == plat_mp_group){
+                actor_flags = ACTOR_COL_TOP;
+            } else {
+                //Anything else in a collision group hurts, so it takes priority for the hit scripts
+                register_actor = hit_actor;
+                continue;
+            }
+            if(!actor_attached || hit_actor != last_actor){
+                UBYTE face = actor_face(hit_actor);
+                if (face == ACTOR_FACE_TOP && pl_vel_y >= 0){
+                    //Attach to MP
+                    last_actor = hit_actor;
+                    actor_ride(&PLAYER, hit_actor);
+                    PLAYER.pos.y = hit_actor->pos.y + (hit_actor->bounds.top << 4) - pl_box_bottom - 4;
+                    //Other cleanup
+                    pl_vel_y = 0;
+                    actor_attached = TRUE;                        
+                    que_state = GROUND_INIT;
+                } else if (actor_flags & ACTOR_COL_SIDES){
+                    //Rising past the top of a solid actor (it moved into the player sideways): push the player out to the side
+                    if (face == ACTOR_FACE_TOP){
+                        face = (PLAYER.pos.x < hit_actor->pos.x) ? ACTOR_FACE_LEFT : ACTOR_FACE_RIGHT;
+                    }
+                    if (face == ACTOR_FACE_BOTTOM){
                         deltaY += (hit_actor->pos.y - PLAYER.pos.y) + ((-PLAYER.bounds.top + hit_actor->bounds.bottom)<<4) + 32;
                         pl_vel_y = plat_grav;
 
                         if(que_state == JUMP_STATE || actor_attached){
                             que_state = FALL_INIT;
                         }
-
-                    } else if (PLAYER.pos.x < hit_actor->pos.x){
-                        deltaX = (hit_actor->pos.x - PLAYER.pos.x) - ((PLAYER.bounds.right + -hit_actor->bounds.left)<<4);
-                        col = 1;
-                        last_wall = 1;
-                        wc_val = plat_coyote_max + 1;
-                        if(!INPUT_RIGHT){
-                            pl_vel_x = 0;
-                        }
-                        if(que_state == DASH_STATE){
-                            que_state = FALL_INIT;
-                        }
-                    } else if (PLAYER.pos.x > hit_actor->pos.x){
-                        deltaX = (hit_actor->pos.x - PLAYER.pos.x) + ((-PLAYER.bounds.left + hit_actor->bounds.right)<<4)+16;
-                        col = -1;
-                        last_wall = -1;
-                        wc_val = plat_coyote_max  + 1;
-                        if (!INPUT_LEFT){
-                            pl_vel_x = 0;
+                    } else {
+                        if (face == ACTOR_FACE_LEFT){
+                            deltaX = (hit_actor->pos.x - PLAYER.pos.x) - ((PLAYER.bounds.right + -hit_actor->bounds.left)<<4);
+                            col = 1;
+                            if(!INPUT_RIGHT){
+                                pl_vel_x = 0;
+                            }
+                        } else {
+                            deltaX = (hit_actor->pos.x - PLAYER.pos.x) + ((-PLAYER.bounds.left + hit_actor->bounds.right)<<4)+16;
+                            col = -1;
+                            if (!INPUT_LEFT){
+                                pl_vel_x = 0;
+                            }
                         }
+                        last_wall = col;
+                        wc_val = plat_coyote_max + 1;
                         if(que_state == DASH_STATE){
                             que_state = FALL_INIT;
                         }
                     }
-
-                }
-            } else if (hit_actor->collision_group == plat_mp_group){
-                //Platform Actors
-                if(!actor_attached || hit_actor != last_actor){
-                    if (temp_y < hit_actor->pos.y + (hit_actor->bounds.top << 4) && pl_vel_y >= 0){
-                        //Attach to MP
-                        last_actor = hit_actor;
-                        mp_last_x = hit_actor->pos.x;
-                        mp_last_y = hit_actor->pos.y;
-                        PLAYER.pos.y = hit_actor->pos.y + (hit_actor->bounds.top << 4) - (PLAYER.bounds.bottom << 4) - 4;
-                        //Other cleanup
-                        pl_vel_y = 0;
-                        actor_attached = TRUE;                        
-                        que_state = GROUND_INIT;
-                    }
                 }
             }
+            if (!register_actor){
+                register_actor = hit_actor;
+            }
+        }
+        if (register_actor) {
             //All Other Collisions
-            player_register_collision_with(hit_actor);
+            player_register_collision_with(register_actor);
         } else if (INPUT_PRESSED(INPUT_PLATFORM_INTERACT)) {
-            if (!hit_actor) {
-                hit_actor = actor_in_front_of_player(8, TRUE);
+            if (!talk_actor) {
+                talk_actor = actor_in_front_of_player(8, TRUE);
             }
-            if (hit_actor && !hit_actor->collision_group && hit_actor->script.bank) {
-                script_execute(hit_actor->script.bank, hit_actor->script.ptr, 0, 1, 0);
+            if (talk_actor && !talk_actor->collision_group && talk_actor->script.bank) {
+                script_execute(talk_actor->script.bank, talk_actor->script.ptr, 0, 1, 0);
             }
         }
     }
@@ -1150,6 +1334,7 @@ void platform_update() BANKED {
 
 
     gotoSwitch2:
+    PP_PROFILE_BEGIN(PP_ZONE_SWITCH2);
     //SWITCH for Animation and State Change==========================================================================
     switch(plat_state){
         case FALL_INIT:
@@ -1166,14 +1351,14 @@ void platform_update() BANKED {
 
             //FALL -> DASH check
             if(dash_press && dash_ready_val == 0){
-                if (plat_dash_style != 0){
+                if (PLAT_DASH_STYLE != 0){
                     if (col == 0 || (col == 1 && !INPUT_RIGHT) || (col == -1 && !INPUT_LEFT)){
                     que_state = DASH_INIT;
                     plat_state = FALL_END;
                     break;
                     }
                 }
-                else if (que_state == GROUND_INIT && plat_dash_style != 1){
+                else if (que_state == GROUND_INIT && PLAT_DASH_STYLE != 1){
                     que_state = DASH_INIT;
                     plat_state = FALL_END;
                     break;
@@ -1269,7 +1454,7 @@ void platform_update() BANKED {
 
             //STATE CHANGE: Above, basic_y_col can shift to FALL_STATE.--------------------------------------------------
             //GROUND -> DASH Check
-            if (dash_press && plat_dash_style != 1 && dash_ready_val == 0) {
+            if (dash_press && PLAT_DASH_STYLE != 1 && dash_ready_val == 0) {
                 que_state = DASH_INIT;
                 plat_state = GROUND_END;
                 break;
@@ -1316,7 +1501,7 @@ void platform_update() BANKED {
 
             //JUMP -> DASH check
             if(dash_press && dash_ready_val == 0){
-                if(plat_dash_style != 0 || ct_val != 0){
+                if(PLAT_DASH_STYLE != 0 || ct_val != 0){
                     que_state = DASH_INIT;
                     plat_state = JUMP_END;
                     break;
@@ -1384,7 +1569,7 @@ void platform_update() BANKED {
                 plat_state = DASH_END;
             }
 
-            if(plat_dash_through >= 2){
+            if(PLAT_DASH_THROUGH >= 2){
                 goto gotoCounters;
             }
 
@@ -1410,7 +1595,7 @@ void platform_update() BANKED {
             wall_check();
             
             //WALL -> DASH Check
-            if(dash_press && plat_dash_style != 0 && dash_ready_val == 0){
+            if(dash_press && PLAT_DASH_STYLE != 0 && dash_ready_val == 0){
                 if ((col == 1 && !INPUT_RIGHT) || (col == -1 && !INPUT_LEFT)){
                     que_state = DASH_INIT;
                     plat_state = WALL_END;
@@ -1456,10 +1641,34 @@ void platform_update() BANKED {
     }
 
     gotoTriggerCol:
+    PP_PROFILE_BEGIN(PP_ZONE_TRIGGERCOL);
     //FUNCTION TRIGGERS
-    trigger_activate_at_intersection(&PLAYER.bounds, &PLAYER.pos, INPUT_UP_PRESSED);
+    {
+        UBYTE tile_left   = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_left);
+        UBYTE tile_right  = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_right);
+        UBYTE tile_top    = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top);
+        UBYTE tile_bottom = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom);
+        if (INPUT_UP_PRESSED || tile_left != trigger_left || tile_right != trigger_right || tile_top != trigger_top || tile_bottom != trigger_bottom){
+            UBYTE near = FALSE;
+            for (UBYTE tx = tile_left; tx != (UBYTE)(tile_right + 1); tx++){
+                if (TRIGGER_COL(tx)){
+                    near = TRUE;
+                    break;
+                }
+            }
+            if (near || trigger_near){
+                trigger_activate_at_intersection(&PLAYER.bounds, &PLAYER.pos, INPUT_UP_PRESSED);
+            }
+            trigger_near = near;
+            trigger_left = tile_left;
+            trigger_right = tile_right;
+            trigger_top = tile_top;
+            trigger_bottom = tile_bottom;
+        }
+    }
 
     gotoCounters:
+    PP_PROFILE_BEGIN(PP_ZONE_COUNTERS);
     //COUNTERS===============================================================
     // Counting down until dashing is ready again
     // XX Set in dash Init and checked in wall, fall, ground, and jump states
@@ -1482,23 +1691,49 @@ void platform_update() BANKED {
     //State-Based Events
 
 
-    //script_execute(BANK(test_symbol0), test_symbol0, 0, 0);
-    //script_event_t * event = &state_events[plat_state];
-    /*if(event->script_bank == test){
-        PLAYER.pos.x += 100;
-        //
-    }*/
-
-    if(state_events[plat_state].script_addr != 0){
-        script_execute(state_events[plat_state].script_bank, state_events[plat_state].script_addr, 0, 0);
+    //Only states with a script attached start a VM thread, and only as often as their mode asks for
+    UBYTE state_entered = FALSE;
+    if (plat_state != script_state){
+        script_state_t *exit_event = &state_events[script_state];
+        if (exit_event->script_addr != 0 && exit_event->script_mode == STATE_SCRIPT_EXIT){
+            script_execute(exit_event->script_bank, exit_event->script_addr, 0, 0);
+        }
+        script_state = plat_state;
+        state_entered = TRUE;
     }
+    script_state_t *event = &state_events[plat_state];
+    if (event->script_addr != 0){
+        switch(event->script_mode){
+            case STATE_SCRIPT_EVERY_FRAME:
+                script_execute(event->script_bank, event->script_addr, 0, 0);
+                break;
+            case STATE_SCRIPT_ENTRY:
+                if (state_entered){
+                    script_execute(event->script_bank, event->script_addr, 0, 0);
+                }
+                break;
+            case STATE_SCRIPT_FINISHED:
+                if (event->script_thread & SCRIPT_TERMINATED){
+                    script_execute(event->script_bank, event->script_addr, &event->script_thread, 0);
+                }
+                break;
+            case STATE_SCRIPT_PERIODIC:
+                if (state_entered || event->script_timer == 0){
+                    script_execute(event->script_bank, event->script_addr, 0, 0);
+                    event->script_timer = event->script_period;
+                }
+                event->script_timer--;
+                break;
+        }
+    }
+    PP_PROFILE_END();
 }
 
 
-void basic_anim() BANKED{
+static void basic_anim(){
     //This animation is currently shared by jumping, dashing, and falling. Dashing doesn't need this complexity though.
     //Here velocity overrides direction. Whereas on the ground it is the reverse. 
-    if(plat_turn_control){
+    if(PLAT_TURN_CONTROL){
         if (INPUT_LEFT){
             PLAYER.dir = DIR_LEFT;
         } else if (INPUT_RIGHT){
@@ -1517,8 +1752,8 @@ void basic_anim() BANKED{
     }
 }
 
-void wall_check() BANKED {
-    if(col != 0 && pl_vel_y >= 0 && plat_wall_slide){
+static void wall_check() {
+    if(col != 0 && pl_vel_y >= 0 && PLAT_WALL_SLIDE){
         if (que_state != WALL_STATE ){
             que_state = WALL_INIT;
         }
@@ -1527,45 +1762,44 @@ void wall_check() BANKED {
     }
 }
 
-void ladder_check() BANKED {
-    UBYTE p_half_width = (PLAYER.bounds.right - PLAYER.bounds.left) >> 1;
+static void ladder_check() {
     if (INPUT_UP || INPUT_DOWN) {
         // Grab upwards ladder
-        UBYTE tile_x_mid = ((PLAYER.pos.x >> 4) + PLAYER.bounds.left + p_half_width) >> 3;
-        UBYTE tile_y   = ((PLAYER.pos.y >> 4) >> 3);
-        if (tile_at(tile_x_mid, tile_y) & TILE_PROP_LADDER) {
-            PLAYER.pos.x = (((tile_x_mid << 3) + 4 - (PLAYER.bounds.left + p_half_width) << 4));
+        UBYTE tile_x_mid = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_mid);
+        UBYTE tile_y   = SUBPX_TO_TILE(PLAYER.pos.y);
+        if (cached_tile_at(tile_x_mid, tile_y) & TILE_PROP_LADDER) {
+            //Centre the player on the ladder (4px into the tile)
+            PLAYER.pos.x = TILE_TO_SUBPX(tile_x_mid) + 64 - pl_box_mid;
             que_state = LADDER_INIT;
             pl_vel_x = 0;
         }
     } 
 }
 
-void ladder_switch() BANKED{
+static void ladder_switch(){
      //For positioning the player in the middle of the ladder
-    UBYTE p_half_width = (PLAYER.bounds.right - PLAYER.bounds.left) >> 1;
-    UBYTE tile_x_mid = ((PLAYER.pos.x >> 4) + PLAYER.bounds.left + p_half_width) >> 3; 
+    UBYTE tile_x_mid = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_mid);
     pl_vel_y = 0;
     if (INPUT_UP) {
         // Climb laddder
-        UBYTE tile_y = ((PLAYER.pos.y >> 4) + PLAYER.bounds.top + 1) >> 3;
+        UBYTE tile_y = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top + 16);
         //Check if the tile above the player is a ladder tile. If so add ladder velocity
-        if (tile_at(tile_x_mid, tile_y) & TILE_PROP_LADDER) {
+        if (cached_tile_at(tile_x_mid, tile_y) & TILE_PROP_LADDER) {
             pl_vel_y = -plat_climb_vel;
         }
     } else if (INPUT_DOWN) {
         // Descend ladder
-        UBYTE tile_y = ((PLAYER.pos.y >> 4) + PLAYER.bounds.bottom + 1) >> 3;
-        if (tile_at(tile_x_mid, tile_y) & TILE_PROP_LADDER) {
+        UBYTE tile_y = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom + 16);
+        if (cached_tile_at(tile_x_mid, tile_y) & TILE_PROP_LADDER) {
             pl_vel_y = plat_climb_vel;
         }
     } else if (INPUT_LEFT) {
         que_state = FALL_INIT; //Assume we're going to leave the ladder state, 
         // Check if able to leave ladder on left
-        UBYTE tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top)    >> 3);
-        UBYTE tile_end   = (((PLAYER.pos.y >> 4) + PLAYER.bounds.bottom) >> 3) + 1;
+        UBYTE tile_start = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top);
+        UBYTE tile_end   = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom) + 1;
         while (tile_start != tile_end) {
-            if (tile_at(tile_x_mid - 1, tile_start) & COLLISION_RIGHT) {
+            if (cached_tile_at(tile_x_mid - 1, tile_start) & COLLISION_RIGHT) {
                 que_state = LADDER_STATE; //If there is a wall, stay on the ladder.
                 break;
             }
@@ -1574,17 +1808,17 @@ void ladder_switch() BANKED{
     } else if (INPUT_RIGHT) {
         que_state = FALL_INIT;
         // Check if able to leave ladder on right
-        UBYTE tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top)    >> 3);
-        UBYTE tile_end   = (((PLAYER.pos.y >> 4) + PLAYER.bounds.bottom) >> 3) + 1;
+        UBYTE tile_start = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top);
+        UBYTE tile_end   = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom) + 1;
         while (tile_start != tile_end) {
-            if (tile_at(tile_x_mid + 1, tile_start) & COLLISION_LEFT) {
+            if (cached_tile_at(tile_x_mid + 1, tile_start) & COLLISION_LEFT) {
                 que_state = LADDER_STATE;
                 break;
             }
             tile_start++;
         }
     }
-    PLAYER.pos.y += (pl_vel_y >> 8);
+    PLAYER.pos.y += VEL_WHOLE(pl_vel_y);
 
     //Animation----------------------------------------------------------------------------------------------------
     actor_set_anim(&PLAYER, ANIM_CLIMB);
@@ -1605,89 +1839,165 @@ void ladder_switch() BANKED{
     }
 }
 
-void dash_init_switch() BANKED{
-    WORD new_x;
-    //If the player is pressing a direction (but not facing a direction, ie on a wall or on a changed frame)
-    if (INPUT_RIGHT){
-        PLAYER.dir = DIR_RIGHT;
+void dash_index_build(UBYTE tile_x, UBYTE len) BANKED{
+    UBYTE tile_start = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top);
+    UBYTE tile_end   = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom) + 1;
+    UBYTE wall = COLLISION_LEFT;
+    BYTE step = 1;
+    if (PLAYER.dir == DIR_LEFT){
+        wall = COLLISION_RIGHT;
+        step = -1;
     }
-    else if(INPUT_LEFT){
-        PLAYER.dir = DIR_LEFT;
+    dash_index_col = tile_x;
+    dash_index_row = tile_start;
+    dash_index_row_end = tile_end;
+    dash_index_len = len;
+    dash_index_dir = PLAYER.dir;
+    dash_wall_dist = DASH_NO_WALL;
+
+    //Walk each row outward, but never further than the closest wall found in the rows above it
+    while (tile_start != tile_end) {
+        UBYTE tile_current = tile_x;
+        for (UBYTE dist = 0; dist != len && dist < dash_wall_dist; dist++){
+            if (cached_tile_at(tile_current, tile_start) & wall){
+                dash_wall_dist = dist;
+                break;
+            }
+            tile_current += step;
+        }
+        tile_start++;
     }
+}
 
-    //Set new_x be the final destination of the dash (ie. the distance covered by all of the dash frames combined)
-    if (PLAYER.dir == DIR_RIGHT){
-        new_x = PLAYER.pos.x + (dash_dist*plat_dash_frames);
+static void pl_box_update(){
+    if (pl_box_bounds.left == PLAYER.bounds.left && pl_box_bounds.right == PLAYER.bounds.right
+        && pl_box_bounds.top == PLAYER.bounds.top && pl_box_bounds.bottom == PLAYER.bounds.bottom){
+        return;
     }
-    else{
-        new_x = PLAYER.pos.x + (-dash_dist*plat_dash_frames);
+    pl_box_bounds = PLAYER.bounds;
+    pl_box_left   = PLAYER.bounds.left << 4;
+    pl_box_right  = PLAYER.bounds.right << 4;
+    pl_box_top    = PLAYER.bounds.top << 4;
+    pl_box_bottom = PLAYER.bounds.bottom << 4;
+    pl_box_mid    = ((PLAYER.bounds.left + PLAYER.bounds.right) >> 1) << 4;
+}
+
+//Sweeps the player's box from the start of the frame to where it is now, and returns the face of the actor it crossed.
+//When both axes were clear, the face the player reached last is the one they hit. A face the player didn't move towards
+//was never reached, and actors that were already overlapping (because they moved into the player) fall back to
+//comparing positions. Everything stays in subpixels, with the player's side taken from the cached hitbox.
+static UBYTE actor_face(actor_t *actor){
+    WORD actor_top    = actor->pos.y + (actor->bounds.top << 4);
+    WORD actor_bottom = actor->pos.y + (actor->bounds.bottom << 4);
+    WORD actor_left   = actor->pos.x + (actor->bounds.left << 4);
+    WORD actor_right  = actor->pos.x + (actor->bounds.right << 4);
+    WORD last_top     = pl_last_y + pl_box_top;
+    WORD last_bottom  = pl_last_y + pl_box_bottom;
+    WORD last_left    = pl_last_x + pl_box_left;
+    WORD last_right   = pl_last_x + pl_box_right;
+    UBYTE face_x = 255, face_y = 255;
+    WORD dist_x, dist_y, move_x = 0, move_y = 0;
+
+    if (last_bottom < actor_top){
+        face_y = ACTOR_FACE_TOP;
+        dist_y = actor_top - last_bottom;
+        move_y = PLAYER.pos.y - pl_last_y;
+    } else if (last_top > actor_bottom){
+        face_y = ACTOR_FACE_BOTTOM;
+        dist_y = last_top - actor_bottom;
+        move_y = pl_last_y - PLAYER.pos.y;
+    }
+    if (move_y <= 0){
+        face_y = 255;
+    }
+    if (last_right < actor_left){
+        face_x = ACTOR_FACE_LEFT;
+        dist_x = actor_left - last_right;
+        move_x = PLAYER.pos.x - pl_last_x;
+    } else if (last_left > actor_right){
+        face_x = ACTOR_FACE_RIGHT;
+        dist_x = last_left - actor_right;
+        move_x = pl_last_x - PLAYER.pos.x;
+    }
+    if (move_x <= 0){
+        face_x = 255;
     }
 
-    //Dash through walls
-    if(plat_dash_through == 3 && plat_dash_momentum < 2){
-        dash_end_clear = true;                              //Assume that the landing spot is clear, and disable if we collide below
-        UBYTE tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top)    >> 3);
-        UBYTE tile_end   = (((PLAYER.pos.y >> 4) + PLAYER.bounds.bottom) >> 3) + 1;     
-
-        //Do a collision check at the final landing spot (but not all the steps in-between.)
-        if (PLAYER.dir == DIR_RIGHT){
-            //Don't dash off the screen to the right
-            if (PLAYER.pos.x + (PLAYER.bounds.right <<4) + (dash_dist*(plat_dash_frames)) > (image_width -16) << 4){   
-                dash_end_clear = false;                                     
-            } else {
-                UBYTE tile_xr = (((new_x >> 4) + PLAYER.bounds.right) >> 3) +1;  
-                UBYTE tile_xl = ((new_x >> 4) + PLAYER.bounds.left) >> 3;   
-                while (tile_xl != tile_xr){                                             //This checks all the tiles between the left bounds and the right bounds
-                    while (tile_start != tile_end) {                                    //This checks all the tiles that the character occupies in height
-                        if (tile_at(tile_xl, tile_start) & COLLISION_ALL) {
-                                dash_end_clear = false;
-                                goto initDash;                                          //Gotos are still good for breaking embedded loops.
-                        }
-                        tile_start++;
-                    }
-                    tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top)    >> 3);   //Reset the height after each loop
-                    tile_xl++;
-                }
-            }
-        } else if(PLAYER.dir == DIR_LEFT) {
-            //Don't dash off the screen to the left
-            if (PLAYER.pos.x <= ((dash_dist*plat_dash_frames)+(PLAYER.bounds.left << 4))+(8<<4)){
-                dash_end_clear = false;         //To get around unsigned position, test if the player's current position is less than the total dist.
-            } else {
-                UBYTE tile_xl = ((new_x >> 4) + PLAYER.bounds.left) >> 3;
-                UBYTE tile_xr = (((new_x >> 4) + PLAYER.bounds.right) >> 3) +1;  
+    if (face_x == 255){
+        if (face_y != 255){
+            return face_y;
+        }
+        //Already overlapping
+        if (PLAYER.pos.y < actor_top){
+            return ACTOR_FACE_TOP;
+        }
+        return (PLAYER.pos.x < actor->pos.x) ? ACTOR_FACE_LEFT : ACTOR_FACE_RIGHT;
+    }
+    //Crossed diagonally: compare the time to reach each face (dist/move) without dividing. This is rare enough that the
+    //32-bit multiply doesn't matter, and subpixel moves can be too long for a 16-bit product.
+    if (face_y == 255 || (UINT32)dist_x * (UWORD)move_y > (UINT32)dist_y * (UWORD)move_x){
+        return face_x;
+    }
+    return face_y;
+}
 
-                while (tile_xl != tile_xr){   
-                    while (tile_start != tile_end) {
-                        if (tile_at(tile_xl, tile_start) & COLLISION_ALL) {
-                                dash_end_clear = false;
-                                goto initDash;
-                        }
-                        tile_start++;
-                    }
-                    tile_start = (((PLAYER.pos.y >> 4) + PLAYER.bounds.top)    >> 3);
-                    tile_xl++;
+//Columns from tile_x (1 to len, in the direction of step) until one with a trigger in the player's rows, 255 if none
+static UBYTE trigger_in_path(UBYTE tile_x, UBYTE len, BYTE step, UBYTE tile_start, UBYTE tile_end){
+    for (UBYTE k = 1; k <= len; k++){
+        tile_x += step;
+        if (TRIGGER_COL(tile_x)){
+            for (UBYTE ty = tile_start; ty != tile_end; ty++){
+                if (trigger_at_tile(tile_x, ty) != NO_TRIGGER_COLLISON){
+                    return k;
                 }
             }
         }
     }
-    initDash:
-    actor_attached = FALSE;
-    camera_deadzone_x = plat_dash_deadzone;
-    dash_ready_val = plat_dash_ready_max + plat_dash_frames;
-    if(plat_dash_momentum < 2){
-        pl_vel_y = 0;
-    }
-    dash_currentframe = plat_dash_frames;
-    tap_val = 0;
-    jump_type = 0;
-    run_stage = 0;
-    que_state = DASH_STATE;
+    return 255;
+}
 
+static void tile_cache_update(){
+    UBYTE tile_x = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_left) - 1;
+    UBYTE tile_y = SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top) - 1;
+    UBYTE dx = tile_x - tile_cache_x;
+    UBYTE dy = tile_y - tile_cache_y;
+    if (dx == 0 && dy == 0){
+        return;
+    }
+    tile_cache_x = tile_x;
+    tile_cache_y = tile_y;
+
+    //Shift the tiles we already have into their new slots, and read the rest from ROM. Walk in the same direction as the
+    //movement so that each slot is read before it gets overwritten. Tile coords wrap at 256 just like the cache offsets.
+    UBYTE row_first = 0, row_end = TILE_CACHE_H;
+    BYTE row_step = 1;
+    if ((BYTE)dy < 0){
+        row_first = TILE_CACHE_H - 1;
+        row_end = 255;
+        row_step = -1;
+    }
+    UBYTE col_first = 0, col_end = TILE_CACHE_W;
+    BYTE col_step = 1;
+    if ((BYTE)dx < 0){
+        col_first = TILE_CACHE_W - 1;
+        col_end = 255;
+        col_step = -1;
+    }
+    for (UBYTE r = row_first; r != row_end; r += row_step){
+        UBYTE old_r = r + dy;
+        for (UBYTE c = col_first; c != col_end; c += col_step){
+            UBYTE old_c = c + dx;
+            if (old_r < TILE_CACHE_H && old_c < TILE_CACHE_W){
+                tile_cache[r][c] = tile_cache[old_r][old_c];
+            } else {
+                tile_cache[r][c] = tile_at(tile_x + c, tile_y + r);
+            }
+        }
+    }
 }
 
-UBYTE drop_press() BANKED{
-    switch(plat_drop_through){
+static UBYTE drop_press(){
+    switch(PLAT_DROP_THROUGH){
         case 1:
         if(INPUT_DOWN){
             return 1;
@@ -1714,17 +2024,28 @@ UBYTE drop_press() BANKED{
 //UBYTE slot, UBYTE bank, UBYTE * pc
 //                      
 void assign_state_script(SCRIPT_CTX * THIS) OLDCALL BANKED {
+    UBYTE *period = VM_REF_TO_PTR(FN_ARG4);
+    UBYTE *mode = VM_REF_TO_PTR(FN_ARG3);
     UWORD *slot = VM_REF_TO_PTR(FN_ARG2);
     UBYTE *bank = VM_REF_TO_PTR(FN_ARG1);
     UBYTE **ptr = VM_REF_TO_PTR(FN_ARG0);
-    state_events[*slot].script_bank = *bank;
-    state_events[*slot].script_addr = *ptr;
+    if (*slot > BLANK_STATE){
+        return;
+    }
+    script_state_t *event = &state_events[*slot];
+    event->script_bank = *bank;
+    event->script_addr = *ptr;
+    event->script_mode = *mode;
+    event->script_period = MAX(*period, 1);
+    event->script_timer = 0;
+    event->script_thread = SCRIPT_TERMINATED;
 }
 
 void clear_state_script(SCRIPT_CTX * THIS) OLDCALL BANKED {
     UWORD *slot = VM_REF_TO_PTR(FN_ARG0);
+    if (*slot > BLANK_STATE){
+        return;
+    }
     state_events[*slot].script_bank = NULL;
     state_events[*slot].script_addr = NULL;
-
-
 }
\ No newline at end of file
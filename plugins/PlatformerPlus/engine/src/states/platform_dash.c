@@ -0,0 +1,131 @@
+#pragma bank 255
+
+//Dash initialization for the platformer state. This only runs on the frame a dash starts, so it lives outside of
+//platform.c's bank to leave room there for the per-frame code.
+
+#include <string.h>
+
+#include "data/states_defines.h"
+#include "states/platform.h"
+#include "states/platform_fields.h"
+
+#include "actor.h"
+#include "camera.h"
+#include "collision.h"
+#include "input.h"
+#include "scroll.h"
+#include "pp_fixed.h"
+#include "pp_slopes.h"
+
+//One bit per column of the dash, set if any tile in the player's rows is solid. Offset 0 is the column the player's
+//leading edge is in when the dash starts, counting in the direction of the dash.
+static UBYTE dash_solid_cols[32];
+static const UBYTE dash_col_bits[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+#define DASH_COL_SOLID(k) (dash_solid_cols[(UBYTE)(k) >> 3] & dash_col_bits[(UBYTE)(k) & 7])
+
+//Fills in dash_solid_cols for the landing search, and builds the same wall index as dash_index_build() from the same
+//reads, so DASH_STATE doesn't scan the columns a second time. Each column is read top to bottom and left as soon as it's
+//settled: once the closest wall is known, the first solid tile is all a column needs. Slope tiles are solid ground for
+//the landing search, but not walls (see COLLISION_TOP_OR_SLOPE).
+static void dash_cols_build(UBYTE tile_x, UBYTE len, UBYTE tile_start, UBYTE tile_end){
+    UBYTE wall = COLLISION_LEFT;
+    BYTE step = 1;
+    if (PLAYER.dir == DIR_LEFT){
+        wall = COLLISION_RIGHT;
+        step = -1;
+    }
+    memset(dash_solid_cols, 0, sizeof(dash_solid_cols));
+    dash_index_col = tile_x;
+    dash_index_row = tile_start;
+    dash_index_row_end = tile_end;
+    dash_index_len = len;
+    dash_index_dir = PLAYER.dir;
+    dash_wall_dist = DASH_NO_WALL;
+
+    for (UBYTE dist = 0; dist != len; dist++){
+        for (UBYTE row = tile_start; row != tile_end; row++){
+            UBYTE tile = cached_tile_at(tile_x, row);
+            if (tile & (COLLISION_ALL | COLLISION_SLOPE)){
+                dash_solid_cols[dist >> 3] |= dash_col_bits[dist & 7];
+                if (dash_wall_dist != DASH_NO_WALL){
+                    break;
+                }
+                if (tile & wall){
+                    dash_wall_dist = dist;
+                    break;
+                }
+            }
+        }
+        tile_x += step;
+    }
+}
+
+void dash_init_switch() BANKED{
+    WORD new_x;
+    UBYTE tile_current;     //Column of the player's leading edge
+    UBYTE len;              //Columns from there to the leading edge at the end of the dash, inclusive
+    //If the player is pressing a direction (but not facing a direction, ie on a wall or on a changed frame)
+    if (INPUT_RIGHT){
+        PLAYER.dir = DIR_RIGHT;
+    }
+    else if(INPUT_LEFT){
+        PLAYER.dir = DIR_LEFT;
+    }
+
+    //Set new_x be the final destination of the dash (ie. the distance covered by all of the dash frames combined)
+    if (PLAYER.dir == DIR_RIGHT){
+        new_x = PLAYER.pos.x + (dash_dist*plat_dash_frames);
+        tile_current = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_right);
+        len = SUBPX_TO_TILE(new_x + pl_box_right) - tile_current + 1;
+    }
+    else{
+        new_x = PLAYER.pos.x + (-dash_dist*plat_dash_frames);
+        tile_current = SUBPX_TO_TILE(PLAYER.pos.x + pl_box_left);
+        len = tile_current - SUBPX_TO_TILE(new_x + pl_box_left) + 1;
+    }
+
+    //Dash through walls
+    dash_end_clear = false;                                 //Assume that there is nowhere to land, and enable if we find a gap below
+    UBYTE indexed = FALSE;
+    if(PLAT_DASH_THROUGH == 3 && PLAT_DASH_MOMENTUM < 2){
+        //Don't dash off the screen to the right, or past the left edge (to get around unsigned position, test if the
+        //player's current position is less than the total dist)
+        if ((PLAYER.dir == DIR_RIGHT && PLAYER.pos.x + pl_box_right + (dash_dist*(plat_dash_frames)) <= (image_width -16) << 4)
+            || (PLAYER.dir == DIR_LEFT && PLAYER.pos.x > ((dash_dist*plat_dash_frames)+pl_box_left)+(8<<4))){
+            UBYTE width = SUBPX_TO_TILE(new_x + pl_box_right) - SUBPX_TO_TILE(new_x + pl_box_left) + 1;   //Columns the player covers at the landing spot
+            UBYTE run = 0;                                  //Clear columns in a row, counting back from the end point
+            dash_cols_build(tile_current, len, SUBPX_TO_TILE(PLAYER.pos.y + pl_box_top), SUBPX_TO_TILE(PLAYER.pos.y + pl_box_bottom) + 1);
+            indexed = TRUE;
+
+            //Look back from the final landing spot towards the player for the first gap the player fits in. The columns are
+            //already indexed, so this is one bit test per column. The landing spot has to be past where the player is now.
+            for (UBYTE k = len - 1; k != 0; k--){
+                if (DASH_COL_SOLID(k)){
+                    run = 0;
+                } else if (++run == width){
+                    //The gap starts k columns ahead of the player, so pull the end point back by the difference in whole tiles
+                    UWORD back = (UWORD)(UBYTE)(len - width - k) << 7;
+                    dash_end_x = (PLAYER.dir == DIR_RIGHT) ? new_x - back : new_x + back;
+                    dash_end_clear = true;
+                    break;
+                }
+            }
+        }
+    }
+    //Index the walls along the whole dash while we're skipping collisions this frame
+    if (!indexed && (PLAT_DASH_THROUGH != 3 || dash_end_clear == FALSE)){
+        dash_index_build(tile_current, len);
+    }
+    actor_attached = FALSE;
+    camera_deadzone_x = plat_dash_deadzone;
+    dash_ready_val = plat_dash_ready_max + plat_dash_frames;
+    if(PLAT_DASH_MOMENTUM < 2){
+        pl_vel_y = 0;
+    }
+    dash_currentframe = plat_dash_frames;
+    tap_val = 0;
+    jump_type = 0;
+    run_stage = 0;
+    que_state = DASH_STATE;
+
+}
@@ -0,0 +1,68 @@
+const id = "PM_EVENT_PLATPLUS_PROFILE_STORE";
+const groups = ["Platformer+", "EVENT_GROUP_VARIABLES"];
+const name = "Store Platformer+ Profiler Timing In a Variable";
+
+const fields = [
+  {
+    label: "Note: Requires PP_PROFILE to be defined in pp_profiler.h, otherwise it stores 0. Times are in DIV ticks (256 cycles, about 274 per frame).",
+  },
+  {
+    key: "zone",
+    label: "Zone",
+    type: "select",
+    defaultValue: "0",
+    options: [
+      ["0", "Platform: Collision Cache and Input Checks"],
+      ["1", "Platform: State Machine 1"],
+      ["2", "Platform: X Collision"],
+      ["3", "Platform: Y Collision"],
+      ["4", "Platform: Actor Collision"],
+      ["5", "Platform: State Machine 2"],
+      ["6", "Platform: Triggers"],
+      ["7", "Platform: Counters and State Scripts"],
+      ["8", "Actors Update"],
+      ["9", "Camera Update"],
+      ["10", "Whole Frame (all of the above)"]
+    ],
+  },
+  {
+    key: "stat",
+    label: "Value",
+    type: "select",
+    defaultValue: "1",
+    options: [
+      ["0", "Minimum"],
+      ["1", "Average"],
+      ["2", "Maximum"]
+    ],
+  },
+  {
+    key: "variable",
+    type: "variable",
+    defaultValue: "LAST_VARIABLE",
+  },
+];
+
+const compile = (input, helpers) => {
+  const { appendRaw, getVariableAlias, _addComment } = helpers;
+
+  //Matches the layout of pp_profile_zone_t
+  const zoneSize = 6;
+  const offset = parseInt(input.zone, 10) * zoneSize + parseInt(input.stat, 10);
+  const variableAlias = getVariableAlias(input.variable);
+
+  _addComment("Store profiler timing in variable");
+  appendRaw(`VM_PUSH_CONST ${offset}`);
+  appendRaw(`VM_CALL_NATIVE b_pp_profile_get, _pp_profile_get`);
+  appendRaw(`VM_SET ${variableAlias}, .ARG0`);
+  appendRaw(`VM_POP 1`);
+};
+
+module.exports = {
+  id,
+  name,
+  groups,
+  fields,
+  compile,
+  allowedBeforeInitFade: true,
+};
@@ -29,8 +29,35 @@ const fields = [
           ["17", "End Wall Slide"],
           ["18", "Knockback State Start"],
           ["19", "Knockback State"],
-          ["21", "Blank State Start"],
-          ["22", "Blank State"]
+          ["20", "Blank State Start"],
+          ["21", "Blank State"]
+        ],
+    },
+    {
+        key: "mode",
+        label: "Run Script",
+        type: "select",
+        defaultValue: "0",
+        options: [
+          ["0", "Every Frame"],
+          ["1", "When Entering the State"],
+          ["2", "When Leaving the State"],
+          ["3", "Every Frame, Once the Last Run Has Finished"],
+          ["4", "Every N Frames"]
+        ],
+    },
+    {
+        key: "period",
+        label: "Frames Between Runs",
+        type: "number",
+        defaultValue: 8,
+        min: 1,
+        max: 255,
+        conditions: [
+          {
+            key: "mode",
+            eq: "4",
+          },
         ],
     },
     {
@@ -63,12 +90,17 @@ const fields = [
     const bank = `___bank_${ScriptRef}`;
     const ptr = `_${ScriptRef}`
 
+    const mode = `${input.mode || 0}`;
+    const period = `${input.period || 1}`;
+
     _addComment("Set Platformer Script");
+    appendRaw(`VM_PUSH_CONST ${period}`);
+    appendRaw(`VM_PUSH_CONST ${mode}`);
     appendRaw(`VM_PUSH_CONST ${stateNumber}`);
     appendRaw(`VM_PUSH_CONST ${bank}`);
     appendRaw(`VM_PUSH_CONST ${ptr}`);
     appendRaw(`VM_CALL_NATIVE b_assign_state_script, _assign_state_script`);
-    appendRaw(`VM_POP 3`);
+    appendRaw(`VM_POP 5`);
   };
   
   module.exports = {
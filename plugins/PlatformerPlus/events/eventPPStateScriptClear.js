@@ -29,8 +29,8 @@ const fields = [
           ["17", "End Wall Slide"],
           ["18", "Knockback State Start"],
           ["19", "Knockback State"],
-          ["21", "Blank State Start"],
-          ["22", "Blank State"]
+          ["20", "Blank State Start"],
+          ["21", "Blank State"]
         ],
     },
   ];
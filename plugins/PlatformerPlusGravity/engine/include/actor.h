@@ -14,6 +14,16 @@
 
 #define PLAYER_HURT_IFRAMES   20
 
+#define MAX_RIDERS            4     // Slot 0 is kept for the player
+
+// Update tiers. Actors away from the player animate and probe the ground at half or quarter rate (a tier lower while shedding).
+#define LOD_AUTO              0     // Tier picked from the distance to the player
+#define LOD_FULL              1
+#define LOD_HALF              2
+#define LOD_QUARTER           3
+#define LOD_HALF_TILE16       3     // Auto actors more than this many 16px tiles from the player (on either axis) run at half rate
+#define LOD_QUARTER_TILE16    5     // and more than this many at quarter rate
+
 #define ANIM_JUMP_LEFT        0
 #define ANIM_JUMP_RIGHT       2
 #define ANIM_CLIMB            6
@@ -32,7 +42,15 @@ typedef enum {
   CHECK_DIR_DOWN,
 } col_check_dir_e;
 
+typedef struct rider_t {
+    actor_t *rider;
+    actor_t *platform;              // NULL when the slot is free
+    upoint16_t platform_last;       // Platform's position when its movement was last handed on
+} rider_t;
+
 extern actor_t actors[MAX_ACTORS];
+extern rider_t riders[MAX_RIDERS];
+extern UBYTE riders_len;                // Rider slots in use, so actors_update() can skip riders_update() when there are none
 extern actor_t * actors_active_head;
 extern actor_t * actors_active_tail;
 extern actor_t * actors_inactive_head;
@@ -45,6 +63,8 @@ extern UBYTE allocated_hardware_sprites;
 
 extern WORD plat_grav;
 extern WORD plat_max_fall_vel;
+extern UBYTE plat_mp_group;
+extern UBYTE actor_attached;
 
 
 void actors_init() BANKED;
@@ -57,6 +77,7 @@ UBYTE actor_get_frame_offset(actor_t *actor) BANKED;
 actor_t *actor_at_tile(UBYTE tx, UBYTE ty, UBYTE inc_noclip) BANKED;
 actor_t *actor_in_front_of_player(UBYTE grid_size, UBYTE inc_noclip) BANKED;
 actor_t *actor_overlapping_player(UBYTE inc_noclip) BANKED;
+UBYTE actors_overlapping_player(actor_t **hits, UBYTE max_hits, UBYTE inc_noclip) BANKED;
 actor_t *actor_overlapping_bb(bounding_box_t *bb, upoint16_t *offset, actor_t *ignore, UBYTE inc_noclip) BANKED;
 void actor_set_anim_idle(actor_t *actor) BANKED;
 void actor_set_anim_moving(actor_t *actor) BANKED;
@@ -82,5 +103,10 @@ void activate_actors_in_col(UBYTE x, UBYTE y) BANKED;
 void player_init() BANKED;
 
 void actor_fall(actor_t *actor) BANKED;
+// Wake every sleeping gravity actor, for anything that changes the ground without moving the actors
+void actors_wake_gravity() BANKED;
+// Move the rider with the platform from now on, until it leaves the platform's edges or is blocked
+void actor_ride(actor_t *rider, actor_t *platform) BANKED;
+void riders_update() BANKED;
 
 #endif
@@ -70,8 +70,18 @@ typedef struct actor_t
     // Collisions
     collision_group_e collision_group;
     bool grav_on              : 1;
+    uint8_t grav_phase        : 3;  // Frame (of 8) this actor probes the ground on, also offsets its animation in lower update tiers
+    bool grav_sleep           : 1;  // Resting on the ground, gravity is skipped until the actor moves
+    upoint16_t grav_rest;           // Position the actor went to sleep at
+    bool riding               : 1;  // Has an entry in riders[], so it moves with a platform actor instead of falling
+    uint8_t lod_priority      : 2;  // LOD_AUTO, or a fixed update tier set by the designer
     int16_t drop_y;
     int16_t vel_y;
+    uint8_t col16_left;         // Broadphase: 16px columns the actor covers, see actor_update_cols()
+    uint8_t col16_right;
+    uint8_t vis_cell_x;         // 16px cell (high byte of pos) the on-screen test was last run for
+    uint8_t vis_cell_y;
+    bool vis_off              : 1;  // Result of that test
 
     // Linked list
     struct actor_t *next;
@@ -15,6 +15,11 @@
 #include "collision.h"
 #include "ui.h"
 #include "vm.h"
+#include "pp_profiler.h"
+#include "pp_fixed.h"
+#include "pp_slopes.h"
+#include "pp_lag.h"
+#include "pp_recorder.h"
 
 #ifdef STRICT
     #include <gb/bgb_emu.h>
@@ -47,6 +52,8 @@ const metasprite_t emote_metasprite[]  = {
 };
 
 actor_t actors[MAX_ACTORS];
+rider_t riders[MAX_RIDERS];
+UBYTE riders_len;
 actor_t * actors_active_head;
 actor_t * actors_active_tail;
 actor_t * actors_inactive_head;
@@ -60,6 +67,32 @@ actor_t * emote_actor;
 UBYTE emote_timer;
 
 UBYTE allocated_hardware_sprites;
+UBYTE grav_phase_next;      // Phase handed to the next activated actor, so ground probes are spread over 8 frames
+
+// Screen's 16px cell the last time actors_update() ran, so actors only retest visibility when it changes
+static UBYTE vis_screen_x, vis_screen_y;
+#define VIS_CELL_NONE 0xFF          // Past the last cell of the largest scene, so a retest is forced
+
+// 16px column range of the current overlap query, widened by one column each side
+static UBYTE query_col16_left, query_col16_right;
+
+// Keep the actor's 16px column span for the overlap broadphase. Uses the high byte of pos.x
+// (offset by 64 like the screen tiles) so it is cheap, at the cost of being up to a column wider.
+inline void actor_update_cols(actor_t *actor) {
+    UBYTE col16 = SUBPX_TO_TILE16(actor->pos.x) + TILE16_OFFSET;
+    actor->col16_left  = col16 + (actor->bounds.left >> 4);
+    actor->col16_right = col16 + (actor->bounds.right >> 4) + 1;
+}
+
+// Spans are refreshed once a frame in actors_update(), so the extra column of slack
+// covers anything that moved since then
+static void actor_query_cols(bounding_box_t *bb, upoint16_t *offset) {
+    WORD x = offset->x >> 4;
+    query_col16_left  = ((x + bb->left)  >> 4) + TILE16_OFFSET - 1;
+    query_col16_right = ((x + bb->right) >> 4) + TILE16_OFFSET + 1;
+}
+
+#define ACTOR_OUTSIDE_QUERY(actor) (((actor)->col16_right < query_col16_left) || ((actor)->col16_left > query_col16_right))
 
 
 void actors_init() BANKED {
@@ -70,6 +103,9 @@ void actors_init() BANKED {
     emote_actor             = NULL;
 
     memset(actors, 0, sizeof(actors));
+    memset(riders, 0, sizeof(riders));
+    riders_len = 0;
+    vis_screen_x = VIS_CELL_NONE;
 }
 
 void player_init() BANKED {
@@ -83,6 +119,15 @@ void actors_update() NONBANKED {
     static actor_t *actor;
     static uint8_t screen_tile16_x, screen_tile16_y;
     static uint8_t actor_tile16_x, actor_tile16_y;
+    static uint8_t grav_frame, grav_cycle;
+    static uint8_t player_tile16_x, player_tile16_y;
+    static uint8_t lod_tier, lod_dx, lod_dy;
+    static uint8_t anim_phase;
+    static uint16_t anim_mask;
+    static uint8_t vis_screen_moved;
+    // Runs every frame, including the ones where a script has the VM locked and the player doesn't update
+    PP_RECORD_INPUT();
+    PP_PROFILE_BEGIN(PP_ZONE_ACTORS_UPDATE);
 
     // Convert scroll pos to 16px tile coordinates
     // allowing full range of scene to be represented in 7 bits
@@ -90,6 +135,18 @@ void actors_update() NONBANKED {
     // unsigned int values (is faster)
     screen_tile16_x = (draw_scroll_x >> 4) + TILE16_OFFSET;
     screen_tile16_y = (draw_scroll_y >> 4) + TILE16_OFFSET;
+    vis_screen_moved = (screen_tile16_x != vis_screen_x) || (screen_tile16_y != vis_screen_y);
+    vis_screen_x = screen_tile16_x;
+    vis_screen_y = screen_tile16_y;
+    grav_frame = game_time & 0x7;
+    grav_cycle = (game_time >> 3) & 0x7;
+    player_tile16_x = SUBPX_TO_TILE16(PLAYER.pos.x);
+    player_tile16_y = SUBPX_TO_TILE16(PLAYER.pos.y);
+
+    // Platforms have finished moving for this frame, so carry their riders along before anything is drawn
+    if (riders_len) {
+        riders_update();
+    }
 
     if (emote_actor) {
         SWITCH_ROM(emote_actor->sprite.bank);
@@ -112,39 +169,70 @@ void actors_update() NONBANKED {
 
     actor = actors_active_tail;
     while (actor) {
+        actor_update_cols(actor);
+        lod_tier = 0;
         if (actor->pinned) {
             screen_x = (actor->pos.x >> 4) + 8, screen_y = (actor->pos.y >> 4) + 8;
         } else {
-            if (actor->grav_on){
-                if(IS_FRAME_8){
-                    if(check_collision_in_direction(actor->pos.x, actor->pos.y, &actor->bounds, actor->pos.y+16, CHECK_DIR_DOWN) == actor->pos.y+16){
-                        actor->drop_y = TRUE;
-                    }
+            // Update tier from the designer's priority, or from the distance to the player (in 16px tiles, on the
+            // furthest axis). While frames are lagging, every actor below full rate drops one tier further, down to eighth rate.
+            if (actor->lod_priority == LOD_AUTO) {
+                lod_dx = SUBPX_TO_TILE16(actor->pos.x) - player_tile16_x;
+                if ((BYTE)lod_dx < 0) lod_dx = -lod_dx;
+                lod_dy = SUBPX_TO_TILE16(actor->pos.y) - player_tile16_y;
+                if ((BYTE)lod_dy < 0) lod_dy = -lod_dy;
+                if (lod_dy > lod_dx) lod_dx = lod_dy;
+                lod_tier = (lod_dx > LOD_QUARTER_TILE16) ? 2 : (lod_dx > LOD_HALF_TILE16) ? 1 : 0;
+            } else {
+                lod_tier = actor->lod_priority - LOD_FULL;
+            }
+            if (lod_tier && pp_shed) lod_tier++;
+            if (actor->grav_on && !actor->riding){
+                // Anything that moved a sleeping actor (scripts, platforms) may have taken the ground away
+                if (actor->grav_sleep && (actor->pos.x != actor->grav_rest.x || actor->pos.y != actor->grav_rest.y)){
+                    actor->grav_sleep = FALSE;
                 }
-                if (actor->drop_y){
-                    actor_fall(actor);
+                if (!actor->grav_sleep){
+                    // Full rate actors probe every 8 frames, each lower tier doubles that (up to 64 while shedding), on their own phase
+                    if(actor->grav_phase == grav_frame && ((grav_cycle ^ actor->grav_phase) & ((1 << lod_tier) - 1)) == 0){
+                        if(check_collision_in_direction(actor->pos.x, actor->pos.y, &actor->bounds, actor->pos.y+16, CHECK_DIR_DOWN) == actor->pos.y+16){
+                            actor->drop_y = TRUE;
+                        } else if (!actor->drop_y){
+                            // Standing on a tile, nothing else to do until it moves
+                            actor->grav_sleep = TRUE;
+                            actor->grav_rest = actor->pos;
+                        }
+                    }
+                    if (actor->drop_y){
+                        actor_fall(actor);
+                    }
                 }
             }
 
 
 
-            screen_x = (actor->pos.x >> 4) - draw_scroll_x + 8, screen_y = (actor->pos.y >> 4) - draw_scroll_y + 8;
-            // Bottom right coordinate of actor in 16px tile coordinates
-            // Subtract bounding box estimate width/height
-            // and offset by 64 to allow signed comparisons with screen tiles
-            actor_tile16_x = (actor->pos.x >> 8) + ACTOR_BOUNDS_TILE16_HALF + TILE16_OFFSET;
-            actor_tile16_y = (actor->pos.y >> 8) + ACTOR_BOUNDS_TILE16_HALF + TILE16_OFFSET;
-
-            if (
-                // Actor right edge < screen left edge
-                (actor_tile16_x < screen_tile16_x) ||
-                // Actor left edge > screen right edge
-                (actor_tile16_x - ACTOR_BOUNDS_TILE16 - SCREEN_TILE16_W > screen_tile16_x) ||
-                // Actor bottom edge < screen top edge
-                (actor_tile16_y < screen_tile16_y) ||
-                // Actor top edge > screen bottom edge
-                (actor_tile16_y - ACTOR_BOUNDS_TILE16 - SCREEN_TILE16_H > screen_tile16_y)
-            ) {
+            // Visibility can only change when the actor moves into another 16px cell or the screen scrolls into one
+            if (vis_screen_moved || SUBPX_TO_TILE16(actor->pos.x) != actor->vis_cell_x || SUBPX_TO_TILE16(actor->pos.y) != actor->vis_cell_y) {
+                actor->vis_cell_x = SUBPX_TO_TILE16(actor->pos.x);
+                actor->vis_cell_y = SUBPX_TO_TILE16(actor->pos.y);
+                // Bottom right coordinate of actor in 16px tile coordinates
+                // Subtract bounding box estimate width/height
+                // and offset by 64 to allow signed comparisons with screen tiles
+                actor_tile16_x = actor->vis_cell_x + ACTOR_BOUNDS_TILE16_HALF + TILE16_OFFSET;
+                actor_tile16_y = actor->vis_cell_y + ACTOR_BOUNDS_TILE16_HALF + TILE16_OFFSET;
+
+                actor->vis_off = (
+                    // Actor right edge < screen left edge
+                    (actor_tile16_x < screen_tile16_x) ||
+                    // Actor left edge > screen right edge
+                    (actor_tile16_x - ACTOR_BOUNDS_TILE16 - SCREEN_TILE16_W > screen_tile16_x) ||
+                    // Actor bottom edge < screen top edge
+                    (actor_tile16_y < screen_tile16_y) ||
+                    // Actor top edge > screen bottom edge
+                    (actor_tile16_y - ACTOR_BOUNDS_TILE16 - SCREEN_TILE16_H > screen_tile16_y)
+                );
+            }
+            if (actor->vis_off) {
                 if (actor->persistent) {
                     actor = actor->prev;
                     continue;
@@ -155,6 +243,7 @@ void actors_update() NONBANKED {
                 actor = prev;
                 continue;
             }
+            screen_x = (actor->pos.x >> 4) - draw_scroll_x + 8, screen_y = (actor->pos.y >> 4) - draw_scroll_y + 8;
         }
         if (NO_OVERLAY_PRIORITY && (!show_actors_on_overlay) && (WX_REG != MINWNDPOSX) && (WX_REG < (UINT8)screen_x + 8) && (WY_REG < (UINT8)(screen_y) - 8)) {
             // Hide if under window (don't deactivate)
@@ -166,7 +255,14 @@ void actors_update() NONBANKED {
         }
 
         // Check reached animation tick frame
-        if ((actor->anim_tick != ANIM_PAUSED) && (game_time & actor->anim_tick) == 0) {
+        // Lower tiers stretch the animation tick by 2, 4 or 8, offset by the actor's phase so they don't all step together
+        anim_mask = actor->anim_tick;
+        anim_phase = 0;
+        if (lod_tier) {
+            anim_mask = (anim_mask << lod_tier) | ((1 << lod_tier) - 1);
+            anim_phase = actor->grav_phase;
+        }
+        if ((actor->anim_tick != ANIM_PAUSED) && ((game_time + anim_phase) & anim_mask) == 0) {
             actor->frame++;
             // Check reached end of animation
             if (actor->frame == actor->frame_end) {
@@ -194,6 +290,7 @@ void actors_update() NONBANKED {
     }
 
     SWITCH_ROM(_save);
+    PP_PROFILE_END();
 }
 
 void deactivate_actor(actor_t *actor) BANKED {
@@ -237,6 +334,10 @@ void activate_actor(actor_t *actor) BANKED {
 #endif
     if (actor->active || actor->disabled) return;
     actor->active = TRUE;
+    actor_update_cols(actor);
+    actor->vis_cell_x = VIS_CELL_NONE;
+    actor->grav_phase = grav_phase_next++;
+    actor->grav_sleep = FALSE;
     actor_set_anim_idle(actor);
     DL_REMOVE_ITEM(actors_inactive_head, actor);
     DL_PUSH_HEAD(actors_active_head, actor);
@@ -338,9 +439,10 @@ actor_t *actor_in_front_of_player(UBYTE grid_size, UBYTE inc_noclip) BANKED {
 
 actor_t *actor_overlapping_player(UBYTE inc_noclip) BANKED {
     actor_t *actor = PLAYER.prev;
+    actor_query_cols(&PLAYER.bounds, &PLAYER.pos);
 
     while (actor) {
-        if (!inc_noclip && !actor->collision_enabled) {
+        if (ACTOR_OUTSIDE_QUERY(actor) || (!inc_noclip && !actor->collision_enabled)) {
             actor = actor->prev;
             continue;
         };
@@ -355,11 +457,63 @@ actor_t *actor_overlapping_player(UBYTE inc_noclip) BANKED {
     return NULL;
 }
 
+UBYTE actors_overlapping_player(actor_t **hits, UBYTE max_hits, UBYTE inc_noclip) BANKED {
+    actor_t *actor = PLAYER.prev;
+    UBYTE hit_count = 0;
+    actor_query_cols(&PLAYER.bounds, &PLAYER.pos);
+
+    while (actor) {
+        if (ACTOR_OUTSIDE_QUERY(actor) || (!inc_noclip && !actor->collision_enabled)) {
+            actor = actor->prev;
+            continue;
+        };
+
+        if (bb_intersects(&PLAYER.bounds, &PLAYER.pos, &actor->bounds, &actor->pos)) {
+            hits[hit_count++] = actor;
+            if (hit_count == max_hits) break;
+        }
+
+        actor = actor->prev;
+    }
+
+    return hit_count;
+}
+
 actor_t *actor_overlapping_bb(bounding_box_t *bb, upoint16_t *offset, actor_t *ignore, UBYTE inc_noclip) BANKED {
     actor_t *actor = &PLAYER;
 
+    // The player can move further than the slack allows between actors_update() calls (e.g. dashing),
+    // so it's always tested directly
+    if (actor != ignore && (inc_noclip || actor->collision_enabled) && bb_intersects(bb, offset, &actor->bounds, &actor->pos)) {
+        return actor;
+    }
+    actor = actor->prev;
+    actor_query_cols(bb, offset);
+
+    while (actor) {
+        if (actor == ignore || ACTOR_OUTSIDE_QUERY(actor) || (!inc_noclip && !actor->collision_enabled)) {
+            actor = actor->prev;
+            continue;
+        };
+
+        if (bb_intersects(bb, offset, &actor->bounds, &actor->pos)) {
+            return actor;
+        }
+
+        actor = actor->prev;
+    }
+
+    return NULL;
+}
+
+// First moving platform (an actor in plat_mp_group) overlapping the box. Anything else overlapping it, the player
+// included, is skipped rather than hiding a platform further down the list.
+static actor_t *platform_overlapping_bb(bounding_box_t *bb, upoint16_t *offset, actor_t *ignore) {
+    actor_t *actor = PLAYER.prev;
+    actor_query_cols(bb, offset);
+
     while (actor) {
-        if (actor == ignore || (!inc_noclip && !actor->collision_enabled)) {
+        if (actor == ignore || actor->collision_group != plat_mp_group || ACTOR_OUTSIDE_QUERY(actor) || !actor->collision_enabled) {
             actor = actor->prev;
             continue;
         };
@@ -455,7 +609,8 @@ UWORD check_collision_in_direction(UWORD start_x, UWORD start_y, bounding_box_t
             while (ty1 != ty2) {
                 tt = tx1;
                 while (tt != tx2) {
-                    if (tile_at(tt, ty1) & COLLISION_TOP) {
+                    // Actors moved this way don't follow slopes, so they stand on top of the tile
+                    if (tile_at(tt, ty1) & COLLISION_TOP_OR_SLOPE) {
                         return ((ty1) << 7) - ((bounds->bottom + 1) << 4);
                     }
                     tt++;
@@ -470,19 +625,49 @@ UWORD check_collision_in_direction(UWORD start_x, UWORD start_y, bounding_box_t
 void actor_fall(actor_t *actor) BANKED {
     actor->vel_y = actor->vel_y + plat_grav;
     UBYTE tile_start, tile_end;
-        tile_start = (((actor->pos.x >> 4) + actor->bounds.left)  >> 3);
-        tile_end   = (((actor->pos.x >> 4) + actor->bounds.right) >> 3) + 1;
-        UWORD new_y = actor->pos.y + (actor->vel_y >> 8);
-        UBYTE tile_y = ((new_y >> 4) + actor->bounds.bottom) >> 3;
+        tile_start = SUBPX_TO_TILE(actor->pos.x + (actor->bounds.left << 4));
+        tile_end   = SUBPX_TO_TILE(actor->pos.x + (actor->bounds.right << 4)) + 1;
+        UWORD new_y = actor->pos.y + VEL_WHOLE(actor->vel_y);
+        UBYTE tile_y = SUBPX_TO_TILE(new_y + (actor->bounds.bottom << 4));
+        // Slopes are checked under the middle of the actor
+        UWORD foot_x = actor->pos.x + (((actor->bounds.left + actor->bounds.right) >> 1) << 4);
+        UBYTE slope_tile = tile_at(SUBPX_TO_TILE(foot_x), tile_y);
+        if (slope_tile & COLLISION_SLOPE) {
+            UWORD slope_y = TILE_TO_SUBPX(tile_y) + SLOPE_SURFACE(slope_tile, SUBPX_TILE_PX(foot_x)) - (actor->bounds.bottom << 4) - 1;
+            if (new_y >= slope_y) {
+                actor->pos.y = slope_y;
+                actor->vel_y = 0;
+                actor->drop_y = FALSE;
+                // Go straight to sleep rather than waiting for the ground probe, which only sees the top of the tile
+                actor->grav_sleep = TRUE;
+                actor->grav_rest = actor->pos;
+                return;
+            }
+            tile_start = tile_end;
+        }
             while (tile_start != tile_end) {
                 if (tile_at(tile_start, tile_y) & COLLISION_TOP) {
-                    new_y = ((((tile_y) << 3) - actor->bounds.bottom) << 4) - 1;
+                    new_y = TILE_TO_SUBPX(tile_y) - (actor->bounds.bottom << 4) - 1;
                     actor->vel_y = 0;
                     actor->drop_y = FALSE;
                     break;
                 }
                 tile_start++;
             }
+            // Land on a platform actor if the actor was above its top last frame
+            if (actor->drop_y && plat_mp_group) {
+                upoint16_t fall_pos = {actor->pos.x, new_y};
+                actor_t *platform = platform_overlapping_bb(&actor->bounds, &fall_pos, actor);
+                if (platform) {
+                    UWORD platform_top = platform->pos.y + (platform->bounds.top << 4);
+                    if (actor->pos.y + (actor->bounds.bottom << 4) < platform_top) {
+                        new_y = platform_top - (actor->bounds.bottom << 4) - 1;
+                        actor->vel_y = 0;
+                        actor->drop_y = FALSE;
+                        actor_ride(actor, platform);
+                    }
+                }
+            }
             actor->pos.y = new_y;
     actor->vel_y = MIN(actor->vel_y, plat_max_fall_vel);
 }
@@ -490,6 +675,97 @@ void actor_fall(actor_t *actor) BANKED {
 void actor_gravity_on(SCRIPT_CTX * THIS) BANKED{
     uint8_t i = *(int16_t*)VM_REF_TO_PTR(FN_ARG0);
     actors[i].grav_on = TRUE;
+    actors[i].grav_sleep = FALSE;
+}
+
+void actors_wake_gravity() BANKED{
+    for (actor_t *actor = actors_active_head; (actor); actor = actor->next) {
+        actor->grav_sleep = FALSE;
+    }
+}
+
+void actor_ride(actor_t *rider, actor_t *platform) BANKED{
+    // Slot 0 is the player's, which platform_update() reads to add the platform's movement to the player's own
+    rider_t *ride = riders;
+    if (rider != &PLAYER) {
+        // Reuse the rider's own slot if it has one, otherwise take the first free slot
+        rider_t *free = NULL;
+        for (UBYTE i = 1; i != MAX_RIDERS; i++) {
+            if (riders[i].platform && riders[i].rider == rider) {
+                free = &riders[i];
+                break;
+            }
+            if (!free && !riders[i].platform) {
+                free = &riders[i];
+            }
+        }
+        if (!free) return;
+        ride = free;
+        rider->riding = TRUE;
+    }
+    if (!ride->platform) {
+        riders_len++;
+    }
+    ride->rider = rider;
+    ride->platform = platform;
+    ride->platform_last = platform->pos;
+}
+
+static void rider_drop(rider_t *ride) {
+    actor_t *rider = ride->rider;
+    ride->platform = NULL;
+    riders_len--;
+    // platform_update() sees the player's slot empty and lets them fall
+    if (rider == &PLAYER) return;
+    rider->riding = FALSE;
+    // Start falling straight away instead of waiting for the ground probe
+    rider->grav_sleep = FALSE;
+    rider->drop_y = TRUE;
+}
+
+// Hand each platform's movement since last frame on to the actors riding it. Riders are moved with the same tile checks
+// as the rest of the engine, and are dropped if a wall stops them, the platform goes away or they move off its edges.
+// The player (slot 0) is only checked here: platform_update() adds the platform's movement to the player's own, so that
+// it goes through the camera and tile checks, and clears actor_attached when the player jumps or lands elsewhere.
+void riders_update() BANKED{
+    rider_t *ride = riders;
+    for (UBYTE i = 0; i != MAX_RIDERS; i++, ride++) {
+        actor_t *platform = ride->platform;
+        if (!platform) continue;
+        actor_t *rider = ride->rider;
+        if (!platform->active || platform->disabled || !rider->active || (i == 0 && !actor_attached)) {
+            rider_drop(ride);
+            continue;
+        }
+        if (i != 0) {
+            WORD dx = platform->pos.x - ride->platform_last.x;
+            WORD dy = platform->pos.y - ride->platform_last.y;
+            ride->platform_last = platform->pos;
+            if (dx) {
+                UWORD new_x = rider->pos.x + dx;
+                rider->pos.x = check_collision_in_direction(rider->pos.x, rider->pos.y, &rider->bounds, new_x, (dx > 0) ? CHECK_DIR_RIGHT : CHECK_DIR_LEFT);
+            }
+            if (dy) {
+                UWORD new_y = rider->pos.y + dy;
+                rider->pos.y = check_collision_in_direction(rider->pos.x, rider->pos.y, &rider->bounds, new_y, (dy > 0) ? CHECK_DIR_DOWN : CHECK_DIR_UP);
+                if (rider->pos.y != new_y) {
+                    // The platform moved through a solid tile, so leave the rider on (or under) it
+                    rider_drop(ride);
+                    continue;
+                }
+            }
+        }
+        WORD rider_x = rider->pos.x >> 4;
+        WORD platform_x = platform->pos.x >> 4;
+        if (rider_x + rider->bounds.right < platform_x + platform->bounds.left || rider_x + rider->bounds.left > platform_x + platform->bounds.right + 1) {
+            rider_drop(ride);
+        }
+    }
+}
+
+void actor_set_priority(SCRIPT_CTX * THIS) BANKED{
+    uint8_t i = *(int16_t*)VM_REF_TO_PTR(FN_ARG0);
+    actors[i].lod_priority = *(int16_t*)VM_REF_TO_PTR(FN_ARG1);
 }
 
 void actor_gravity_off(SCRIPT_CTX * THIS) BANKED{
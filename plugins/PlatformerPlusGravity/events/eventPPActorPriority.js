@@ -0,0 +1,46 @@
+const id = "PM_EVENT_ACTOR_UPDATE_PRIORITY";
+const groups = ["EVENT_GROUP_ACTOR", "Platformer+"];
+const name = "Set Actor Update Priority";
+
+const fields = [
+  {
+    key: "actorId",
+    label: "Actor",
+    description: "Set Actor Update Priority",
+    type: "actor",
+    defaultValue: "$self$",
+  },
+  {
+    key: "priority",
+    label: "Priority",
+    type: "select",
+    defaultValue: "0",
+    options: [
+      ["0", "Automatic (by distance from the player)"],
+      ["1", "Always Full Rate"],
+      ["2", "Always Half Rate"],
+      ["3", "Always Quarter Rate"]
+    ],
+  },
+];
+
+const compile = (input, helpers) => {
+    const { _addComment, _addNL, _callNative, _stackPushConst, _stackPop, actorPushById } =
+      helpers;
+      _addComment("Sets actor update priority");
+      _stackPushConst(parseInt(input.priority, 10));
+      actorPushById(input.actorId);
+      _callNative("actor_set_priority");
+      _stackPop(2);
+  
+    _addNL();
+  };
+  
+  module.exports = {
+    id,
+    name,
+    groups,
+    fields,
+    compile,
+    allowedBeforeInitFade: true,
+  };
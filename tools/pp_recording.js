@@ -0,0 +1,98 @@
+#!/usr/bin/env node
+// Reads a Platformer+ input recording out of a cartridge save (.sav) file.
+// Build the game with PP_RECORD defined in pp_recorder.h to make one.
+//
+// Usage: node pp_recording.js game.sav [--bank 3] [--frames]
+//   Prints the recording as JSON: one entry per scene, with the player's start position
+//   and the (joypad, frames) runs played in it. Runs the player didn't move in, because a
+//   script had the VM locked, have "paused" as a third element.
+//   With --frames, prints one line per frame instead: the joypad byte in hex, a "# scene"
+//   line wherever a scene starts, and "# paused" / "# resumed" lines around those runs.
+
+const fs = require("fs");
+
+const BANK_SIZE = 0x2000;
+const HEADER_SIZE = 6;
+const MARK_SCENE = 0;
+const MARK_PAUSED = 1;
+const MARK_RESUMED = 2;
+
+const args = process.argv.slice(2);
+const file = args.find((arg, i) => !arg.startsWith("--") && args[i - 1] !== "--bank");
+const bankArg = args.indexOf("--bank");
+const bank = bankArg === -1 ? 3 : parseInt(args[bankArg + 1], 10);
+const frames = args.includes("--frames");
+
+if (!file) {
+  console.error("Usage: node pp_recording.js game.sav [--bank 3] [--frames]");
+  process.exit(1);
+}
+
+const sav = fs.readFileSync(file);
+const start = bank * BANK_SIZE;
+if (sav.length < start + BANK_SIZE) {
+  console.error(`${file} is too small to have SRAM bank ${bank}`);
+  process.exit(1);
+}
+const data = sav.subarray(start, start + BANK_SIZE);
+// PPR1 recordings only have scene markers, and leave out the frames the player didn't update in
+const magic = data.toString("latin1", 0, 4);
+if (magic !== "PPR1" && magic !== "PPR2") {
+  console.error(`No recording found in SRAM bank ${bank}`);
+  process.exit(1);
+}
+
+const length = data.readUInt16LE(4);
+const scenes = [];
+let scene = null;
+let paused = false;
+let i = HEADER_SIZE;
+const end = HEADER_SIZE + length;
+while (i + 1 < end) {
+  const joy = data[i];
+  const count = data[i + 1];
+  if (count === 0 && (joy === MARK_PAUSED || joy === MARK_RESUMED)) {
+    paused = joy === MARK_PAUSED;
+    i += 2;
+    continue;
+  }
+  if (count === 0 && joy === MARK_SCENE) {
+    if (i + 9 > end) break;
+    scene = {
+      bank: data[i + 2],
+      ptr: data.readUInt16LE(i + 3),
+      x: data.readUInt16LE(i + 5),
+      y: data.readUInt16LE(i + 7),
+      inputs: [],
+    };
+    scenes.push(scene);
+    i += 9;
+    continue;
+  }
+  if (!scene) {
+    // Input from before the first platformer scene, such as a title screen
+    scene = { bank: null, ptr: null, x: null, y: null, inputs: [] };
+    scenes.push(scene);
+  }
+  scene.inputs.push(paused ? [joy, count, "paused"] : [joy, count]);
+  i += 2;
+}
+
+if (frames) {
+  const lines = [];
+  let linesPaused = false;
+  for (const s of scenes) {
+    lines.push(`# scene bank=${s.bank} ptr=0x${(s.ptr || 0).toString(16)} x=${s.x} y=${s.y}`);
+    for (const [joy, count, state] of s.inputs) {
+      if ((state === "paused") !== linesPaused) {
+        linesPaused = !linesPaused;
+        lines.push(linesPaused ? "# paused" : "# resumed");
+      }
+      const hex = joy.toString(16).padStart(2, "0");
+      for (let f = 0; f < count; f++) lines.push(hex);
+    }
+  }
+  console.log(lines.join("\n"));
+} else {
+  console.log(JSON.stringify(scenes, null, 2));
+}
@@ -0,0 +1,11 @@
+#ifndef PP_SIM_BANKDATA_H
+#define PP_SIM_BANKDATA_H
+
+#include <gb/gb.h>
+
+typedef struct far_ptr_t {
+    UBYTE bank;
+    void * ptr;
+} far_ptr_t;
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef PP_SIM_COLLISION_H
+#define PP_SIM_COLLISION_H
+
+#include <gb/gb.h>
+
+#define COLLISION_TOP       0x1
+#define COLLISION_BOTTOM    0x2
+#define COLLISION_LEFT      0x4
+#define COLLISION_RIGHT     0x8
+#define COLLISION_ALL       0xF
+#define TILE_PROP_LADDER    0x10
+
+typedef struct bounding_box_t {
+    BYTE left, right, top, bottom;
+} bounding_box_t;
+
+typedef struct upoint16_t {
+    UWORD x, y;
+} upoint16_t;
+
+typedef struct point16_t {
+    WORD x, y;
+} point16_t;
+
+typedef struct point8_t {
+    BYTE x, y;
+} point8_t;
+
+typedef enum {
+    DIR_DOWN = 0,
+    DIR_RIGHT,
+    DIR_UP,
+    DIR_LEFT,
+    DIR_NONE
+} direction_e;
+
+#define N_DIRECTIONS 4
+
+extern UBYTE image_tile_width;
+extern UBYTE image_tile_height;
+
+//Collision byte of a tile, read from the loaded map (see map.c). Tiles outside the map are solid, as in the engine.
+UBYTE tile_at(UBYTE tx, UBYTE ty);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef PP_SIM_STATES_DEFINES_H
+#define PP_SIM_STATES_DEFINES_H
+
+//Generated by GB Studio from the project's input and camera settings. Empty here, so the engine defaults apply.
+
+#endif
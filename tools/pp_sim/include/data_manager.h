@@ -0,0 +1,8 @@
+#ifndef PP_SIM_DATA_MANAGER_H
+#define PP_SIM_DATA_MANAGER_H
+
+#include "bankdata.h"
+
+extern far_ptr_t current_scene;
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef PP_SIM_GAME_TIME_H
+#define PP_SIM_GAME_TIME_H
+
+#include <gb/gb.h>
+
+extern UWORD game_time;
+
+#endif
@@ -0,0 +1,4 @@
+#ifndef PP_SIM_CGB_H
+#define PP_SIM_CGB_H
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef PP_SIM_GB_H
+#define PP_SIM_GB_H
+
+//Host stand-in for GBDK's gb.h: the types and joypad bits the engine uses, with the banking keywords defined away.
+//Note that the host's int is 32 bits where SDCC's is 16, so expressions that only fit because of integer promotion
+//on the host can still overflow on the Game Boy.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef int8_t      BYTE;
+typedef uint8_t     UBYTE;
+typedef int16_t     WORD;
+typedef uint16_t    UWORD;
+typedef int8_t      INT8;
+typedef uint8_t     UINT8;
+typedef int16_t     INT16;
+typedef uint16_t    UINT16;
+typedef int32_t     INT32;
+typedef uint32_t    UINT32;
+
+#define BANKED
+#define NONBANKED
+#define OLDCALL
+#define BANKREF(x)
+#define BANKREF_EXTERN(x)
+#define BANK(x)     1
+
+#define TRUE    1
+#define FALSE   0
+
+#define J_RIGHT     0x01U
+#define J_LEFT      0x02U
+#define J_UP        0x04U
+#define J_DOWN      0x08U
+#define J_A         0x10U
+#define J_B         0x20U
+#define J_SELECT    0x40U
+#define J_START     0x80U
+
+//SRAM is never touched by the harness (PP_RECORD stays off)
+#define ENABLE_RAM
+#define DISABLE_RAM
+#define SWITCH_RAM(b)   ((void)(b))
+
+//DIV_REG is the free-running counter the profiler reads. It stays at 0, since the profiler is off in the harness.
+//sys_time counts VBlanks, and the runner advances it once a frame.
+extern UBYTE DIV_REG;
+extern UWORD sys_time;
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef PP_SIM_METASPRITES_H
+#define PP_SIM_METASPRITES_H
+
+#include <gb/gb.h>
+
+typedef struct metasprite_t {
+    INT8 dy, dx;
+    UINT8 dtile;
+    UINT8 props;
+} metasprite_t;
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef PP_SIM_INPUT_H
+#define PP_SIM_INPUT_H
+
+#include <gb/gb.h>
+
+#define INPUT_UP            (joy & J_UP)
+#define INPUT_DOWN          (joy & J_DOWN)
+#define INPUT_LEFT          (joy & J_LEFT)
+#define INPUT_RIGHT         (joy & J_RIGHT)
+#define INPUT_A             (joy & J_A)
+#define INPUT_B             (joy & J_B)
+#define INPUT_START         (joy & J_START)
+#define INPUT_SELECT        (joy & J_SELECT)
+#define INPUT_A_OR_B        (joy & (J_A | J_B))
+
+#define INPUT_PRESSED(key)  ((joy & ~last_joy) & (key))
+
+#define INPUT_UP_PRESSED    INPUT_PRESSED(J_UP)
+#define INPUT_DOWN_PRESSED  INPUT_PRESSED(J_DOWN)
+#define INPUT_LEFT_PRESSED  INPUT_PRESSED(J_LEFT)
+#define INPUT_RIGHT_PRESSED INPUT_PRESSED(J_RIGHT)
+#define INPUT_A_PRESSED     INPUT_PRESSED(J_A)
+#define INPUT_B_PRESSED     INPUT_PRESSED(J_B)
+
+extern UBYTE joy;
+extern UBYTE last_joy;
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef PP_SIM_MATH_H
+#define PP_SIM_MATH_H
+
+#include <gb/gb.h>
+#include "collision.h"
+
+#define MIN(A, B)           ((A) < (B) ? (A) : (B))
+#define MAX(A, B)           ((A) > (B) ? (A) : (B))
+#define CLAMP(A, B, C)      ((A) < (B) ? (B) : (A) > (C) ? (C) : (A))
+#define MOD_8(A)            ((A) & 0x7)
+#define MOD_16(A)           ((A) & 0xF)
+
+inline UBYTE bb_intersects(bounding_box_t *bb_a, upoint16_t *offset_a, bounding_box_t *bb_b, upoint16_t *offset_b) {
+    if (((offset_b->x >> 4) + bb_b->left > (offset_a->x >> 4) + bb_a->right) ||
+        ((offset_b->x >> 4) + bb_b->right < (offset_a->x >> 4) + bb_a->left)) return FALSE;
+    if (((offset_b->y >> 4) + bb_b->top > (offset_a->y >> 4) + bb_a->bottom) ||
+        ((offset_b->y >> 4) + bb_b->bottom < (offset_a->y >> 4) + bb_a->top)) return FALSE;
+    return TRUE;
+}
+
+#endif
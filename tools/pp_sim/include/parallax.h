@@ -0,0 +1,12 @@
+#ifndef PP_SIM_PARALLAX_H
+#define PP_SIM_PARALLAX_H
+
+#include <gb/gb.h>
+
+typedef struct parallax_row_t {
+    UBYTE scx;
+    UBYTE next_y;
+    UBYTE shift;
+} parallax_row_t;
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef PP_SIM_SCROLL_H
+#define PP_SIM_SCROLL_H
+
+#include <gb/gb.h>
+
+extern INT16 scroll_x, scroll_y;
+extern INT16 draw_scroll_x, draw_scroll_y;
+extern UINT16 image_width, image_height;
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef PP_SIM_TRIGGER_H
+#define PP_SIM_TRIGGER_H
+
+#include <gb/gb.h>
+#include "gbs_types.h"
+
+#define MAX_TRIGGERS            31
+#define NO_TRIGGER_COLLISON     0xFF
+
+extern trigger_t triggers[MAX_TRIGGERS];
+extern UBYTE triggers_len;
+
+UBYTE trigger_at_tile(UBYTE tx_a, UBYTE ty_a) BANKED;
+UBYTE trigger_activate_at_intersection(bounding_box_t *bb, upoint16_t *offset, UBYTE force_enter) BANKED;
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef PP_SIM_VM_H
+#define PP_SIM_VM_H
+
+#include <gb/gb.h>
+
+#define VM_MAX_CONTEXTS     16
+#define SCRIPT_TERMINATED   0x8000
+
+typedef struct SCRIPT_CTX {
+    const UBYTE * PC;
+    UBYTE bank;
+    UWORD * stack_ptr;
+    UWORD * base_addr;
+    UWORD ID;
+    UWORD * hthread;
+    UBYTE terminated;
+    struct SCRIPT_CTX * next;
+} SCRIPT_CTX;
+
+#define FN_ARG0 -1
+#define FN_ARG1 -2
+#define FN_ARG2 -3
+#define FN_ARG3 -4
+#define FN_ARG4 -5
+#define FN_ARG5 -6
+
+extern UWORD script_memory[];
+#define VM_REF_TO_PTR(idx) (void *)(((idx) < 0) ? THIS->stack_ptr + (idx) : script_memory + (idx))
+
+//The harness never locks the VM
+#define VM_ISLOCKED() (FALSE)
+
+//Scripts aren't run: the runner counts the calls, and hands back a handle that has already finished
+UBYTE script_execute(UBYTE bank, UBYTE * pc, UWORD * handle, UBYTE nargs, ...) BANKED;
+
+#endif
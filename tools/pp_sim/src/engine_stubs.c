@@ -0,0 +1,268 @@
+#include <string.h>
+
+#include "sim.h"
+#include "actor.h"
+#include "camera.h"
+#include "collision.h"
+#include "data_manager.h"
+#include "game_time.h"
+#include "input.h"
+#include "math.h"
+#include "scroll.h"
+#include "trigger.h"
+#include "vm.h"
+#include "states/platform.h"
+
+//What the rest of the GB Studio engine provides to platform.c, reduced to what a headless run needs. Nothing is drawn
+//and no scripts run: the runner only counts the scripts the engine asks for.
+
+//Moving platforms go this many subpixels a frame, and turn around after SIM_PLATFORM_FRAMES frames
+#define SIM_PLATFORM_SPEED  8
+#define SIM_PLATFORM_FRAMES 64
+
+//Engine state
+UBYTE joy, last_joy;
+UWORD game_time;
+UWORD sys_time;
+UBYTE DIV_REG;
+INT16 scroll_x, scroll_y;
+INT16 draw_scroll_x, draw_scroll_y;
+far_ptr_t current_scene;
+UWORD script_memory[64];
+
+actor_t actors[MAX_ACTORS];
+rider_t riders[MAX_RIDERS];
+UBYTE riders_len;
+actor_t * player_collision_actor;
+
+unsigned long sim_scripts;
+unsigned long sim_triggers;
+UBYTE sim_trigger_hit;
+static UBYTE sim_last_trigger;
+
+//External definitions of the engine's inline helpers
+extern inline void actor_set_anim(actor_t *actor, UBYTE anim);
+extern inline void actor_reset_anim(actor_t *actor);
+extern inline void actor_stop_anim(actor_t *actor);
+extern inline void player_register_collision_with(actor_t *actor);
+extern inline UBYTE bb_intersects(bounding_box_t *bb_a, upoint16_t *offset_a, bounding_box_t *bb_b, upoint16_t *offset_b);
+
+//Actors
+
+void actor_set_frames(actor_t *actor, UBYTE frame_start, UBYTE frame_end) BANKED {
+    if (actor->frame_start != frame_start || actor->frame_end != frame_end) {
+        actor->frame = frame_start;
+        actor->frame_start = frame_start;
+        actor->frame_end = frame_end;
+    }
+}
+
+void actor_set_anim_idle(actor_t *actor) BANKED {
+    actor_set_anim(actor, actor->dir);
+}
+
+void actor_set_anim_moving(actor_t *actor) BANKED {
+    actor_set_anim(actor, actor->dir + N_DIRECTIONS);
+}
+
+void actor_set_dir(actor_t *actor, direction_e dir, UBYTE moving) BANKED {
+    actor->dir = dir;
+    if (moving) {
+        actor_set_anim_moving(actor);
+    } else {
+        actor_set_anim_idle(actor);
+    }
+}
+
+UBYTE actors_overlapping_player(actor_t **hits, UBYTE max_hits, UBYTE inc_noclip) BANKED {
+    UBYTE hit_count = 0;
+    for (actor_t *actor = actors + 1; actor != actors + 1 + sim_actors_len; actor++) {
+        if (!actor->active || (!inc_noclip && !actor->collision_enabled)) {
+            continue;
+        }
+        if (bb_intersects(&PLAYER.bounds, &PLAYER.pos, &actor->bounds, &actor->pos)) {
+            hits[hit_count++] = actor;
+            if (hit_count == max_hits) break;
+        }
+    }
+    return hit_count;
+}
+
+actor_t *actor_in_front_of_player(UBYTE grid_size, UBYTE inc_noclip) BANKED {
+    upoint16_t offset = PLAYER.pos;
+    if (PLAYER.dir == DIR_LEFT) {
+        offset.x -= grid_size << 4;
+    } else if (PLAYER.dir == DIR_RIGHT) {
+        offset.x += grid_size << 4;
+    } else if (PLAYER.dir == DIR_UP) {
+        offset.y -= grid_size << 4;
+    } else {
+        offset.y += grid_size << 4;
+    }
+    for (actor_t *actor = actors + 1; actor != actors + 1 + sim_actors_len; actor++) {
+        if (!actor->active || (!inc_noclip && !actor->collision_enabled)) {
+            continue;
+        }
+        if (bb_intersects(&PLAYER.bounds, &offset, &actor->bounds, &actor->pos)) {
+            return actor;
+        }
+    }
+    return NULL;
+}
+
+//Only the player rides in the harness, in slot 0 like the engine
+void actor_ride(actor_t *rider, actor_t *platform) BANKED {
+    if (rider != &PLAYER) {
+        return;
+    }
+    if (!riders[0].platform) {
+        riders_len++;
+    }
+    riders[0].rider = rider;
+    riders[0].platform = platform;
+    riders[0].platform_last = platform->pos;
+}
+
+//The player's slot of actor.c's riders_update(): let go of the platform once the player is off its edges or has left it
+void riders_update() BANKED {
+    rider_t *ride = riders;
+    actor_t *platform = ride->platform;
+    if (!platform) {
+        return;
+    }
+    WORD rider_x = PLAYER.pos.x >> 4;
+    WORD platform_x = platform->pos.x >> 4;
+    if (!platform->active || platform->disabled || !actor_attached ||
+        rider_x + PLAYER.bounds.right < platform_x + platform->bounds.left || rider_x + PLAYER.bounds.left > platform_x + platform->bounds.right + 1) {
+        ride->platform = NULL;
+        riders_len--;
+    }
+}
+
+//Moves the platforms. The player is carried by platform_update(), and nothing else rides in the harness.
+void actors_update() NONBANKED {
+    for (UBYTE i = 1; i != sim_actors_len + 1; i++) {
+        if (sim_actor_kind[i] != SIM_ACTOR_PLATFORM) {
+            continue;
+        }
+        actor_t *actor = &actors[i];
+        actor->pos.x += ((game_time / SIM_PLATFORM_FRAMES) & 1) ? -SIM_PLATFORM_SPEED : SIM_PLATFORM_SPEED;
+    }
+    if (riders_len) {
+        riders_update();
+    }
+}
+
+//Triggers
+
+UBYTE trigger_at_tile(UBYTE tx_a, UBYTE ty_a) BANKED {
+    for (UBYTE i = 0; i != triggers_len; i++) {
+        trigger_t *trigger = &triggers[i];
+        if (tx_a >= trigger->x && tx_a < trigger->x + trigger->width && ty_a >= trigger->y && ty_a < trigger->y + trigger->height) {
+            return i;
+        }
+    }
+    return NO_TRIGGER_COLLISON;
+}
+
+static UBYTE trigger_at_intersection(bounding_box_t *bb, upoint16_t *offset) {
+    UBYTE tx_a = ((offset->x >> 4) + bb->left) >> 3;
+    UBYTE ty_a = ((offset->y >> 4) + bb->top) >> 3;
+    UBYTE tx_b = ((offset->x >> 4) + bb->right) >> 3;
+    UBYTE ty_b = ((offset->y >> 4) + bb->bottom) >> 3;
+    for (UBYTE i = 0; i != triggers_len; i++) {
+        trigger_t *trigger = &triggers[i];
+        if (tx_b >= trigger->x && tx_a < trigger->x + trigger->width && ty_b >= trigger->y && ty_a < trigger->y + trigger->height) {
+            return i;
+        }
+    }
+    return NO_TRIGGER_COLLISON;
+}
+
+UBYTE trigger_activate_at_intersection(bounding_box_t *bb, upoint16_t *offset, UBYTE force_enter) BANKED {
+    UBYTE hit_trigger = trigger_at_intersection(bb, offset);
+    UBYTE trigger_script_called = FALSE;
+    if (hit_trigger != NO_TRIGGER_COLLISON && (hit_trigger != sim_last_trigger || force_enter)) {
+        sim_triggers++;
+        sim_trigger_hit = hit_trigger;
+        trigger_script_called = TRUE;
+    }
+    sim_last_trigger = hit_trigger;
+    return trigger_script_called;
+}
+
+//Scripts
+
+UBYTE script_execute(UBYTE bank, UBYTE * pc, UWORD * handle, UBYTE nargs, ...) BANKED {
+    (void)bank; (void)pc; (void)nargs;
+    sim_scripts++;
+    if (handle) {
+        *handle = SCRIPT_TERMINATED;
+    }
+    return TRUE;
+}
+
+//Frame loop
+
+//Same as the engine's scroll_update(): the screen is centred on the camera, without leaving the scene
+static void scroll_update(void) {
+    scroll_x = CLAMP(camera_x - SCREEN_WIDTH_HALF, 0, (INT16)(image_width - SCREEN_WIDTH));
+    scroll_y = CLAMP(camera_y - SCREEN_HEIGHT_HALF, 0, (INT16)(image_height - SCREEN_HEIGHT));
+    draw_scroll_x = scroll_x;
+    draw_scroll_y = scroll_y;
+}
+
+//Loads the scene again, the way the engine does when a scene starts: actors first, then the camera, then the state
+void sim_scene_start(UWORD x, UWORD y) {
+    memset(actors, 0, sizeof(actors));
+    memset(riders, 0, sizeof(riders));
+    riders_len = 0;
+    for (UBYTE i = 0; i != sim_actors_len + 1; i++) {
+        actor_t *actor = &actors[i];
+        actor->active = TRUE;
+        actor->collision_enabled = TRUE;
+        actor->dir = DIR_RIGHT;
+        actor->bounds.left = 0;
+        actor->bounds.right = 15;
+        if (i == 0) {
+            actor->pos.x = x ? x : sim_start_x;
+            actor->pos.y = y ? y : sim_start_y;
+            actor->bounds.top = -8;
+            actor->bounds.bottom = 7;
+            actor->collision_group = COLLISION_GROUP_PLAYER;
+            continue;
+        }
+        actor->pos.x = sim_actor_x[i];
+        actor->pos.y = sim_actor_y[i];
+        actor->bounds.top = 0;
+        if (sim_actor_kind[i] == SIM_ACTOR_SOLID) {
+            actor->bounds.bottom = 15;
+            actor->collision_group = COLLISION_GROUP_2;
+        } else {
+            actor->bounds.bottom = 7;
+            actor->collision_group = COLLISION_GROUP_1;
+        }
+    }
+    //platform_init() normalises some of the settings in place, so they're set again for every scene
+    sim_fields_default();
+    joy = last_joy = 0;
+    sim_last_trigger = NO_TRIGGER_COLLISON;
+    camera_init();
+    platform_init();
+    scroll_update();
+}
+
+void sim_frame(UBYTE input, UBYTE paused) {
+    last_joy = joy;
+    joy = input;
+    sim_trigger_hit = NO_TRIGGER_COLLISON;
+    //One VBlank per frame, so the engine never sees lag
+    sys_time++;
+    camera_update();
+    scroll_update();
+    actors_update();
+    if (!paused) {
+        platform_update();
+    }
+    game_time++;
+}
@@ -0,0 +1,80 @@
+#include <string.h>
+
+#include "sim.h"
+#include "camera.h"
+#include "states/platform.h"
+
+//Fields from GB Studio's platformer settings, and the ones PlatformerPlus and PlatformerCamera add in their engine.json.
+//The values are the defaults a new project starts with.
+#define FIELD(name, value) { #name, &name, sizeof(name), value }
+
+sim_field_t sim_fields[] = {
+    FIELD(plat_min_vel, 304),
+    FIELD(plat_walk_vel, 6400),
+    FIELD(plat_run_vel, 10496),
+    FIELD(plat_climb_vel, 4000),
+    FIELD(plat_walk_acc, 152),
+    FIELD(plat_run_acc, 228),
+    FIELD(plat_dec, 208),
+    FIELD(plat_jump_vel, 16384),
+    FIELD(plat_grav, 1792),
+    FIELD(plat_hold_grav, 512),
+    FIELD(plat_max_fall_vel, 20000),
+    FIELD(plat_camera_deadzone_x, 4),
+    FIELD(plat_camera_block, 0),
+    FIELD(plat_drop_through, 0),
+    FIELD(plat_mp_group, 0),
+    FIELD(plat_solid_group, 0),
+    FIELD(plat_jump_min, 0),
+    FIELD(plat_hold_jump_max, 1),
+    FIELD(plat_extra_jumps, 0),
+    FIELD(plat_jump_reduction, 0),
+    FIELD(plat_coyote_max, 0),
+    FIELD(plat_buffer_max, 0),
+    FIELD(plat_wall_jump_max, 0),
+    FIELD(plat_wall_slide, 0),
+    FIELD(plat_wall_grav, 1792),
+    FIELD(plat_wall_kick, 600),
+    FIELD(plat_float_input, 0),
+    FIELD(plat_float_grav, 912),
+    FIELD(plat_air_control, 1),
+    FIELD(plat_turn_control, 1),
+    FIELD(plat_air_dec, 208),
+    FIELD(plat_run_type, 1),
+    FIELD(plat_turn_acc, 712),
+    FIELD(plat_run_boost, 0),
+    FIELD(plat_dash, 0),
+    FIELD(plat_dash_style, 0),
+    FIELD(plat_dash_momentum, 0),
+    FIELD(plat_dash_through, 0),
+    FIELD(plat_dash_dist, 800),
+    FIELD(plat_dash_frames, 5),
+    FIELD(plat_dash_ready_max, 10),
+    FIELD(plat_dash_deadzone, 4),
+    FIELD(plat_camera_follow, 15),
+    FIELD(plat_camera_lead, 0),
+    FIELD(plat_camera_catchup, 0),
+    FIELD(plat_camera_catchup_y, 0),
+    FIELD(plat_camera_scroll_cap, 0),
+    { NULL, NULL, 0, 0 }
+};
+
+void sim_fields_default(void) {
+    for (sim_field_t *field = sim_fields; field->name; field++) {
+        if (field->size == 1) {
+            *(UBYTE *)field->ptr = (UBYTE)field->value;
+        } else {
+            *(UWORD *)field->ptr = (UWORD)field->value;
+        }
+    }
+}
+
+UBYTE sim_field_set(const char *name, long value) {
+    for (sim_field_t *field = sim_fields; field->name; field++) {
+        if (strcmp(field->name, name) == 0) {
+            field->value = (WORD)value;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "camera.h"
+#include "collision.h"
+#include "math.h"
+#include "trigger.h"
+#include "pp_fixed.h"
+#include "pp_slopes.h"
+
+//Map cells, one character per 8px tile. Anything not listed here is an error.
+#define MAP_EMPTY       '.'
+#define MAP_SOLID       '#'
+#define MAP_PLATFORM    '-'     //Can be jumped through from below and dropped through
+#define MAP_LADDER      'H'
+#define MAP_TRIGGER     'T'     //Empty tile covered by a trigger. Touching cells in a row make one trigger.
+#define MAP_PLAYER      'P'     //Top left tile of the player's 16x16 box
+#define MAP_ACTOR_SOLID 'S'     //Top left tile of a solid actor
+#define MAP_ACTOR_MP    'M'     //Left tile of a moving platform
+
+UBYTE sim_map[SIM_MAP_MAX][SIM_MAP_MAX];
+UBYTE image_tile_width;
+UBYTE image_tile_height;
+UINT16 image_width;
+UINT16 image_height;
+
+trigger_t triggers[MAX_TRIGGERS];
+UBYTE triggers_len;
+
+UWORD sim_start_x;
+UWORD sim_start_y;
+UBYTE sim_actor_kind[MAX_ACTORS];
+UWORD sim_actor_x[MAX_ACTORS];
+UWORD sim_actor_y[MAX_ACTORS];
+UBYTE sim_actors_len;
+
+sim_input_t sim_input[SIM_INPUT_MAX];
+unsigned long sim_input_len;
+
+UBYTE tile_at(UBYTE tx, UBYTE ty) {
+    //The engine never reads outside the scene on purpose, but a player pushed against its edges can
+    if (tx >= image_tile_width || ty >= image_tile_height) {
+        return COLLISION_ALL;
+    }
+    return sim_map[ty][tx];
+}
+
+static BYTE map_cell(char c, UBYTE *tile) {
+    switch (c) {
+        case MAP_EMPTY:
+        case MAP_TRIGGER:
+        case MAP_PLAYER:
+        case MAP_ACTOR_SOLID:
+        case MAP_ACTOR_MP:  *tile = 0; return TRUE;
+        case MAP_SOLID:     *tile = COLLISION_ALL; return TRUE;
+        case MAP_PLATFORM:  *tile = COLLISION_TOP; return TRUE;
+        case MAP_LADDER:    *tile = TILE_PROP_LADDER; return TRUE;
+        case '/':           *tile = COLLISION_SLOPE_45_UP; return TRUE;
+        case '\\':          *tile = COLLISION_SLOPE_45_DOWN; return TRUE;
+        case 'a':           *tile = COLLISION_SLOPE_22_UP_LOW; return TRUE;
+        case 'b':           *tile = COLLISION_SLOPE_22_UP_HIGH; return TRUE;
+        case 'c':           *tile = COLLISION_SLOPE_22_DOWN_HIGH; return TRUE;
+        case 'd':           *tile = COLLISION_SLOPE_22_DOWN_LOW; return TRUE;
+    }
+    return FALSE;
+}
+
+static void map_trigger(UBYTE x, UBYTE y, UBYTE width) {
+    //Grow the trigger from the row above if it covers exactly the same columns
+    for (UBYTE i = 0; i != triggers_len; i++) {
+        if (triggers[i].x == x && triggers[i].width == width && triggers[i].y + triggers[i].height == y) {
+            triggers[i].height++;
+            return;
+        }
+    }
+    if (triggers_len == MAX_TRIGGERS) {
+        fprintf(stderr, "pp_sim: more than %d triggers, ignoring the one at %d,%d\n", MAX_TRIGGERS, x, y);
+        return;
+    }
+    trigger_t *trigger = &triggers[triggers_len++];
+    memset(trigger, 0, sizeof(trigger_t));
+    trigger->x = x;
+    trigger->y = y;
+    trigger->width = width;
+    trigger->height = 1;
+    trigger->script_flags = TRIGGER_HAS_ENTER_SCRIPT;
+}
+
+static void map_actor(UBYTE kind, UBYTE x, UBYTE y) {
+    if (sim_actors_len == SIM_ACTORS_MAX) {
+        fprintf(stderr, "pp_sim: more than %d actors, ignoring the one at %d,%d\n", SIM_ACTORS_MAX, x, y);
+        return;
+    }
+    sim_actors_len++;
+    sim_actor_kind[sim_actors_len] = kind;
+    sim_actor_x[sim_actors_len] = TILE_TO_SUBPX(x);
+    sim_actor_y[sim_actors_len] = TILE_TO_SUBPX(y);
+}
+
+UBYTE sim_map_load(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return FALSE;
+    }
+    char line[SIM_MAP_MAX + 8];
+    UBYTE player = FALSE;
+    UWORD y = 0;
+    memset(sim_map, 0, sizeof(sim_map));
+    image_tile_width = 0;
+    triggers_len = 0;
+    sim_actors_len = 0;
+    while (fgets(line, sizeof(line), file)) {
+        size_t len = strcspn(line, "\r\n");
+        if (line[0] == ';') {
+            continue;
+        }
+        if (len > SIM_MAP_MAX || y == SIM_MAP_MAX) {
+            fprintf(stderr, "%s:%d: maps can be at most %d tiles wide and tall\n", path, y + 1, SIM_MAP_MAX);
+            fclose(file);
+            return FALSE;
+        }
+        UBYTE trigger_x = 0, trigger_width = 0;
+        for (UBYTE x = 0; x != len; x++) {
+            if (!map_cell(line[x], &sim_map[y][x])) {
+                fprintf(stderr, "%s:%d: unknown map cell '%c'\n", path, y + 1, line[x]);
+                fclose(file);
+                return FALSE;
+            }
+            if (line[x] == MAP_TRIGGER) {
+                if (trigger_width == 0) {
+                    trigger_x = x;
+                }
+                trigger_width++;
+            } else if (trigger_width) {
+                map_trigger(trigger_x, y, trigger_width);
+                trigger_width = 0;
+            }
+            if (line[x] == MAP_PLAYER) {
+                //The player's box reaches 8px above its position and 7px below
+                sim_start_x = TILE_TO_SUBPX(x);
+                sim_start_y = TILE_TO_SUBPX(y + 1);
+                player = TRUE;
+            } else if (line[x] == MAP_ACTOR_SOLID) {
+                map_actor(SIM_ACTOR_SOLID, x, y);
+            } else if (line[x] == MAP_ACTOR_MP) {
+                map_actor(SIM_ACTOR_PLATFORM, x, y);
+            }
+        }
+        if (trigger_width) {
+            map_trigger(trigger_x, y, trigger_width);
+        }
+        if (len > image_tile_width) {
+            image_tile_width = len;
+        }
+        y++;
+    }
+    fclose(file);
+    if (!player) {
+        fprintf(stderr, "%s: no player start ('%c')\n", path, MAP_PLAYER);
+        return FALSE;
+    }
+    //A scene is never smaller than the screen
+    image_tile_width = MAX(image_tile_width, SCREEN_WIDTH / 8);
+    image_tile_height = MAX(y, SCREEN_HEIGHT / 8);
+    image_width = image_tile_width * 8;
+    image_height = image_tile_height * 8;
+    return TRUE;
+}
+
+UBYTE sim_input_load(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return FALSE;
+    }
+    char line[256];
+    unsigned long line_no = 0;
+    UBYTE scene = FALSE;
+    UBYTE paused = FALSE;
+    UWORD scene_x = 0, scene_y = 0;
+    sim_input_len = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_no++;
+        //"# scene ... x=<subpixels> y=<subpixels>", as written by pp_recording.js --frames. The position is optional.
+        if (strncmp(line, "# scene", 7) == 0) {
+            char *x = strstr(line, " x=");
+            char *y = strstr(line, " y=");
+            scene = TRUE;
+            scene_x = (x && strncmp(x, " x=null", 7) != 0) ? (UWORD)strtoul(x + 3, NULL, 10) : 0;
+            scene_y = (y && strncmp(y, " y=null", 7) != 0) ? (UWORD)strtoul(y + 3, NULL, 10) : 0;
+            continue;
+        }
+        //"# paused" and "# resumed" go around frames where a script had the VM locked
+        if (strncmp(line, "# paused", 8) == 0 || strncmp(line, "# resumed", 9) == 0) {
+            paused = (line[2] == 'p');
+            continue;
+        }
+        if (line[0] == '#' || line[strspn(line, " \t\r\n")] == 0) {
+            continue;
+        }
+        //"<joypad in hex> [frames]"
+        char *end;
+        unsigned long joy = strtoul(line, &end, 16);
+        unsigned long count = strtoul(end, &end, 10);
+        if (end == line || joy > 0xFF) {
+            fprintf(stderr, "%s:%lu: expected a joypad byte in hex\n", path, line_no);
+            fclose(file);
+            return FALSE;
+        }
+        if (count == 0) {
+            count = 1;
+        }
+        while (count--) {
+            if (sim_input_len == SIM_INPUT_MAX) {
+                fprintf(stderr, "%s: more than %d frames of input\n", path, SIM_INPUT_MAX);
+                fclose(file);
+                return FALSE;
+            }
+            sim_input_t *input = &sim_input[sim_input_len++];
+            input->joy = (UBYTE)joy;
+            input->scene = scene;
+            input->scene_x = scene_x;
+            input->scene_y = scene_y;
+            input->paused = paused;
+            scene = FALSE;
+        }
+    }
+    fclose(file);
+    return TRUE;
+}
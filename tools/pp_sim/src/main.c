@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sim.h"
+#include "actor.h"
+#include "camera.h"
+#include "trigger.h"
+#include "states/platform.h"
+
+//Frames each benchmark configuration runs for unless --frames says otherwise
+#define BENCH_FRAMES 2000000UL
+
+//Settings a benchmark configuration changes from the defaults (and from --set)
+#define BENCH_MAX_SETTINGS 6
+
+typedef struct bench_setting_t {
+    const char *name;
+    WORD value;
+} bench_setting_t;
+
+typedef struct bench_config_t {
+    const char *label;
+    bench_setting_t settings[BENCH_MAX_SETTINGS];
+} bench_config_t;
+
+//Each group changes one thing from the defaults, so its rows can be compared with each other
+static const bench_config_t bench_configs[] = {
+    { "run: none",              { { "plat_run_type", 0 } } },
+    { "run: gbs smooth",        { { "plat_run_type", 1 } } },
+    { "run: enhanced smooth",   { { "plat_run_type", 2 } } },
+    { "run: immediate",         { { "plat_run_type", 3 } } },
+    { "run: two levels",        { { "plat_run_type", 4 } } },
+    { "run: three levels",      { { "plat_run_type", 5 } } },
+    { "dash: off",              { { "plat_dash", 0 } } },
+    { "dash: interact",         { { "plat_dash", 1 }, { "plat_dash_style", 2 } } },
+    { "dash: double tap",       { { "plat_dash", 2 }, { "plat_dash_style", 2 } } },
+    { "dash: down and jump",    { { "plat_dash", 3 }, { "plat_dash_style", 2 } } },
+    { "dash: through walls",    { { "plat_dash", 2 }, { "plat_dash_style", 2 }, { "plat_dash_through", 3 } } },
+    { "jump: single",           { { "plat_hold_jump_max", 1 } } },
+    { "jump: held",             { { "plat_hold_jump_max", 10 }, { "plat_jump_min", 2000 } } },
+    { "jump: double and float", { { "plat_hold_jump_max", 10 }, { "plat_extra_jumps", 1 }, { "plat_float_input", 1 } } },
+    { "jump: wall",             { { "plat_wall_jump_max", 2 }, { "plat_wall_slide", 1 }, { "plat_coyote_max", 5 }, { "plat_buffer_max", 5 } } },
+};
+
+static const char * const state_names[] = {
+    "FALL_INIT", "FALL_STATE", "FALL_END",
+    "GROUND_INIT", "GROUND_STATE", "GROUND_END",
+    "JUMP_INIT", "JUMP_STATE", "JUMP_END",
+    "DASH_INIT", "DASH_STATE", "DASH_END",
+    "LADDER_INIT", "LADDER_STATE", "LADDER_END",
+    "WALL_INIT", "WALL_STATE", "WALL_END",
+    "KNOCKBACK_INIT", "KNOCKBACK_STATE",
+    "BLANK_INIT", "BLANK_STATE",
+};
+
+static void usage(void) {
+    fprintf(stderr,
+        "Usage: pp_sim [options] map.txt input.txt\n"
+        "  Plays the input on the map and prints the player's state, position and velocity for every frame.\n"
+        "Options:\n"
+        "  --set field=value   Change an engine field from its default (e.g. --set plat_run_type=3)\n"
+        "  --fields            List the engine fields and their defaults\n"
+        "  --bench             Time each run style, dash input and jump setup instead of printing a trace\n"
+        "  --frames N          Frames per benchmark configuration (default %lu)\n",
+        BENCH_FRAMES);
+}
+
+//Plays the input once, restarting the scene wherever the recording does
+static void trace(void) {
+    printf("# frame joy state x y vel_x vel_y camera_x camera_y\n");
+    for (unsigned long i = 0; i != sim_input_len; i++) {
+        sim_input_t *input = &sim_input[i];
+        if (input->scene) {
+            sim_scene_start(input->scene_x, input->scene_y);
+        }
+        sim_frame(input->joy, input->paused);
+        printf("%lu %02x %s %u %u %d %d %d %d", i, input->joy, state_names[plat_state],
+            PLAYER.pos.x, PLAYER.pos.y, pl_vel_x, pl_vel_y, camera_x, camera_y);
+        if (sim_trigger_hit != NO_TRIGGER_COLLISON) {
+            printf(" trigger=%u", sim_trigger_hit);
+        }
+        if (input->paused) {
+            printf(" paused");
+        }
+        printf("\n");
+    }
+    printf("# scripts %lu triggers %lu\n", sim_scripts, sim_triggers);
+}
+
+//Plays the input on a loop for the given number of frames, and returns the frames per second
+static double bench_run(unsigned long frames) {
+    struct timespec start, end;
+    unsigned long i = 0, total = frames;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    sim_scene_start(sim_input[0].scene_x, sim_input[0].scene_y);
+    while (frames--) {
+        sim_input_t *input = &sim_input[i];
+        if (input->scene && i != 0) {
+            sim_scene_start(input->scene_x, input->scene_y);
+        }
+        sim_frame(input->joy, input->paused);
+        if (++i == sim_input_len) {
+            i = 0;
+            sim_scene_start(sim_input[0].scene_x, sim_input[0].scene_y);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    return (seconds > 0) ? total / seconds : 0;
+}
+
+static void bench(unsigned long frames) {
+    static WORD saved[128];
+    UBYTE fields_len = 0;
+    while (sim_fields[fields_len].name) {
+        saved[fields_len] = sim_fields[fields_len].value;
+        fields_len++;
+    }
+    printf("%-24s %12s %14s\n", "configuration", "frames", "frames/sec");
+    for (UBYTE c = 0; c != sizeof(bench_configs) / sizeof(bench_configs[0]); c++) {
+        const bench_config_t *config = &bench_configs[c];
+        for (UBYTE s = 0; s != BENCH_MAX_SETTINGS && config->settings[s].name; s++) {
+            sim_field_set(config->settings[s].name, config->settings[s].value);
+        }
+        double rate = bench_run(frames);
+        printf("%-24s %12lu %14.0f\n", config->label, frames, rate);
+        for (UBYTE f = 0; f != fields_len; f++) {
+            sim_fields[f].value = saved[f];
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *paths[2];
+    UBYTE paths_len = 0;
+    char *sets[64];
+    UBYTE sets_len = 0;
+    UBYTE bench_mode = FALSE;
+    unsigned long frames = BENCH_FRAMES;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--set") == 0 && i + 1 < argc && sets_len != sizeof(sets) / sizeof(sets[0])) {
+            sets[sets_len++] = argv[++i];
+        } else if (strcmp(argv[i], "--fields") == 0) {
+            for (sim_field_t *field = sim_fields; field->name; field++) {
+                printf("%s=%d\n", field->name, field->value);
+            }
+            return 0;
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            bench_mode = TRUE;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-' && paths_len != 2) {
+            paths[paths_len++] = argv[i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (paths_len != 2) {
+        usage();
+        return 1;
+    }
+    if (!sim_map_load(paths[0]) || !sim_input_load(paths[1])) {
+        return 1;
+    }
+    if (sim_input_len == 0) {
+        fprintf(stderr, "%s: no input\n", paths[1]);
+        return 1;
+    }
+    //Actors from the map need their collision groups picked in the settings to do anything
+    if (sim_actors_len) {
+        sim_field_set("plat_mp_group", COLLISION_GROUP_1);
+        sim_field_set("plat_solid_group", COLLISION_GROUP_2);
+    }
+    for (UBYTE i = 0; i != sets_len; i++) {
+        char *value = strchr(sets[i], '=');
+        if (!value) {
+            usage();
+            return 1;
+        }
+        *value++ = 0;
+        if (!sim_field_set(sets[i], strtol(value, NULL, 0))) {
+            fprintf(stderr, "pp_sim: no engine field called %s (see --fields)\n", sets[i]);
+            return 1;
+        }
+    }
+    //Always start with a scene, even if the input doesn't have a scene line
+    sim_input[0].scene = TRUE;
+
+    if (bench_mode) {
+        bench(frames);
+    } else {
+        trace();
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef PP_SIM_H
+#define PP_SIM_H
+
+#include <gb/gb.h>
+#include <stdio.h>
+
+#include "actor.h"
+
+//Largest map and input recording the runner will load
+#define SIM_MAP_MAX         255
+#define SIM_INPUT_MAX       0x40000
+
+//Actors the map can place besides the player
+#define SIM_ACTORS_MAX      (MAX_ACTORS - 1)
+
+//Kinds of actor the map can place
+#define SIM_ACTOR_SOLID     0   //'S': a 16x16 block in the solid actor group
+#define SIM_ACTOR_PLATFORM  1   //'M': a 16x8 platform in the moving platform group, going back and forth
+
+//A frame of input, or the start of a new scene
+typedef struct sim_input_t {
+    UBYTE joy;
+    UBYTE scene;            //Restart the scene before this frame, at scene_x/scene_y (or the map's start if those are 0)
+    UWORD scene_x;
+    UWORD scene_y;
+    UBYTE paused;           //A script had the VM locked, so the engine ran this frame without platform_update()
+} sim_input_t;
+
+//Engine field the runner can set by name, with the value GB Studio gives it when the project doesn't change it
+typedef struct sim_field_t {
+    const char *name;
+    void *ptr;
+    UBYTE size;
+    WORD value;
+} sim_field_t;
+
+extern sim_field_t sim_fields[];
+
+extern sim_input_t sim_input[SIM_INPUT_MAX];
+extern unsigned long sim_input_len;
+
+extern UWORD sim_start_x;           //Player start from the map's 'P', in subpixels
+extern UWORD sim_start_y;
+extern UBYTE sim_actor_kind[MAX_ACTORS];   //Indexed like actors[], with the player at 0
+extern UWORD sim_actor_x[MAX_ACTORS];
+extern UWORD sim_actor_y[MAX_ACTORS];
+extern UBYTE sim_actors_len;        //Actors placed by the map, not counting the player
+extern unsigned long sim_scripts;   //Scripts the engine started (state scripts, interact)
+extern unsigned long sim_triggers;  //Trigger enter scripts the engine started
+extern UBYTE sim_trigger_hit;       //Trigger entered this frame, NO_TRIGGER_COLLISON if none
+
+//Engine fields (fields.c)
+void sim_fields_default(void);
+UBYTE sim_field_set(const char *name, long value);
+
+//Map and recordings (load.c)
+UBYTE sim_map_load(const char *path);
+UBYTE sim_input_load(const char *path);
+
+//Engine loop (engine_stubs.c)
+void sim_scene_start(UWORD x, UWORD y);
+void sim_frame(UBYTE input, UBYTE paused);
+
+#endif